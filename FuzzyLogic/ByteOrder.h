@@ -0,0 +1,30 @@
+// ByteOrder.h
+#ifndef ByteOrder_h // Include guard to prevent multiple inclusions
+#define ByteOrder_h
+
+#include <stdint.h>
+
+// Little-endian field writers/readers for the binary record layouts (telemetry, flash
+// log), independent of the CPU's byte order. The writers return the position after the
+// field so a record is built with a chain of calls.
+
+inline uint8_t* putLe16(uint8_t* p, uint16_t value) {
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+  return p + 2;
+}
+
+inline uint8_t* putLe32(uint8_t* p, uint32_t value) {
+  p = putLe16(p, (uint16_t)value);
+  return putLe16(p, (uint16_t)(value >> 16));
+}
+
+inline uint16_t getLe16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+inline uint32_t getLe32(const uint8_t* p) {
+  return getLe16(p) | ((uint32_t)getLe16(p + 2) << 16);
+}
+
+#endif // End of include guard
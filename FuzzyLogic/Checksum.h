@@ -0,0 +1,21 @@
+// Checksum.h
+#ifndef Checksum_h // Include guard to prevent multiple inclusions
+#define Checksum_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF), bitwise: the records it
+// protects (telemetry frames, flash log pages) are small, so no table is spent on it.
+// crc continues a previous result, so a record can be checked in pieces.
+inline uint16_t crc16Ccitt(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF) {
+  while (length--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+#endif // End of include guard
@@ -0,0 +1,89 @@
+// CoTask.cpp
+#include "CoTask.h" // Include the header file we just defined
+
+#if FUZZY_COROUTINES
+
+// Frame storage. Aligned for any type a coroutine frame may contain.
+alignas(max_align_t) static uint8_t framePool[COTASK_FRAME_SLOTS][COTASK_FRAME_SIZE];
+static bool frameInUse[COTASK_FRAME_SLOTS];
+
+// allocate method implementation: first free slot, or nullptr if the frame is too big or
+// every slot is taken (the coroutine then reports allocation failure instead of starting)
+void* CoFramePool::allocate(size_t size) {
+  if (size > COTASK_FRAME_SIZE) {
+    return nullptr;
+  }
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    if (!frameInUse[i]) {
+      frameInUse[i] = true;
+      return framePool[i];
+    }
+  }
+  return nullptr;
+}
+
+// release method implementation
+void CoFramePool::release(void* frame) {
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    if (frame == framePool[i]) {
+      frameInUse[i] = false;
+      return;
+    }
+  }
+}
+
+// Constructor implementation
+CoExecutor::CoExecutor() {
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    tasks[i] = nullptr;
+  }
+}
+
+// spawn method implementation
+bool CoExecutor::spawn(CoTask task) {
+  std::coroutine_handle<CoTask::promise_type> h = task.release();
+  if (!h) {
+    return false; // Frame allocation failed
+  }
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    if (!tasks[i]) {
+      h.promise().wakeAtMillis = millis(); // Run on the next poll()
+      tasks[i] = h;
+      return true;
+    }
+  }
+  h.destroy();
+  return false;
+}
+
+// poll method implementation
+void CoExecutor::poll() {
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    std::coroutine_handle<CoTask::promise_type> h = tasks[i];
+    if (!h) {
+      continue;
+    }
+    CoTask::promise_type& promise = h.promise();
+    bool due = (long)(millis() - promise.wakeAtMillis) >= 0; // Deadline or timeout reached
+    bool ready = promise.readyCheck != nullptr && promise.readyCheck(promise.readyContext);
+    if (!due && !ready) {
+      continue;
+    }
+    h.resume(); // Runs until the task's next co_await (or its end)
+    if (h.done()) {
+      h.destroy();
+      tasks[i] = nullptr;
+    }
+  }
+}
+
+// activeCount method implementation
+uint8_t CoExecutor::activeCount() const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < COTASK_FRAME_SLOTS; i++) {
+    if (tasks[i]) count++;
+  }
+  return count;
+}
+
+#endif // FUZZY_COROUTINES
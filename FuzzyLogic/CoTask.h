@@ -0,0 +1,129 @@
+// CoTask.h
+#ifndef CoTask_h // Include guard to prevent multiple inclusions
+#define CoTask_h
+
+#include "FuzzyConfig.h"
+
+#if FUZZY_COROUTINES
+
+#include <Arduino.h>
+#include <coroutine>
+
+// Minimal C++20 coroutine task model for the irrigation sketch.
+//
+// A CoTask is a coroutine that runs until it co_awaits one of the awaitables below
+// (sleepFor/sleepUntil/waitUntil) and is later resumed by CoExecutor::poll() once the
+// wait is over. Nothing ever blocks: poll() only resumes tasks that are ready and
+// returns immediately otherwise.
+//
+// Coroutine frames never come from the heap. They are carved out of a fixed pool of
+// COTASK_FRAME_SLOTS slots of COTASK_FRAME_SIZE bytes; a coroutine whose frame does not
+// fit simply fails to start (CoExecutor::spawn() returns false).
+
+#ifndef COTASK_FRAME_SLOTS
+#define COTASK_FRAME_SLOTS 4     // Maximum number of live coroutines
+#endif
+#ifndef COTASK_FRAME_SIZE
+#define COTASK_FRAME_SIZE 384    // Bytes per coroutine frame (locals + compiler bookkeeping)
+#endif
+
+// Statically allocated storage for coroutine frames.
+class CoFramePool {
+  public:
+    static void* allocate(size_t size);
+    static void release(void* frame);
+};
+
+class CoTask {
+  public:
+    struct promise_type {
+      unsigned long wakeAtMillis = 0;           // Resume at (or after) this millis() time
+      bool (*readyCheck)(void*) = nullptr;      // Optional condition that also resumes the task
+      void* readyContext = nullptr;             // Argument passed to readyCheck
+
+      CoTask get_return_object() { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+      static CoTask get_return_object_on_allocation_failure() { return CoTask(); }
+      std::suspend_always initial_suspend() noexcept { return {}; } // Started by the executor
+      std::suspend_always final_suspend() noexcept { return {}; }   // Destroyed by the executor
+      void return_void() {}
+      void unhandled_exception() { abort(); }
+
+      static void* operator new(size_t size) noexcept { return CoFramePool::allocate(size); }
+      static void operator delete(void* frame) noexcept { CoFramePool::release(frame); }
+    };
+
+    CoTask() : handle(nullptr) {}
+    CoTask(CoTask&& other) : handle(other.handle) { other.handle = nullptr; }
+    ~CoTask() { if (handle) handle.destroy(); }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    // Hands the coroutine over to the caller (the executor). The CoTask is empty afterwards.
+    std::coroutine_handle<promise_type> release() {
+      std::coroutine_handle<promise_type> h = handle;
+      handle = nullptr;
+      return h;
+    }
+
+  private:
+    explicit CoTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Awaitable: suspends the task until millis() reaches wakeAtMillis.
+struct CoSleep {
+  unsigned long wakeAtMillis;
+
+  bool await_ready() const noexcept { return (long)(millis() - wakeAtMillis) >= 0; }
+  void await_suspend(std::coroutine_handle<CoTask::promise_type> h) const noexcept {
+    h.promise().wakeAtMillis = wakeAtMillis;
+    h.promise().readyCheck = nullptr;
+  }
+  void await_resume() const noexcept {}
+};
+
+// Awaitable: suspends the task until ready(context) returns true or the deadline passes.
+// co_await yields true if the condition was met, false on timeout.
+struct CoWait {
+  bool (*ready)(void*);
+  void* context;
+  unsigned long deadlineMillis;
+
+  bool await_ready() const noexcept { return ready(context); }
+  void await_suspend(std::coroutine_handle<CoTask::promise_type> h) const noexcept {
+    h.promise().wakeAtMillis = deadlineMillis;
+    h.promise().readyCheck = ready;
+    h.promise().readyContext = context;
+  }
+  bool await_resume() const noexcept { return ready(context); }
+};
+
+inline CoSleep sleepFor(unsigned long ms) { return CoSleep{millis() + ms}; }
+inline CoSleep sleepUntil(unsigned long wakeAtMillis) { return CoSleep{wakeAtMillis}; }
+inline CoWait waitUntil(bool (*ready)(void*), void* context, unsigned long timeoutMs) {
+  return CoWait{ready, context, millis() + timeoutMs};
+}
+
+// Fixed-size round-robin executor. Call poll() as often as possible from loop()
+// (or from a FreeRTOS task); it resumes every task whose wait is over and returns.
+class CoExecutor {
+  public:
+    CoExecutor();
+
+    // Takes ownership of a coroutine and schedules it to start on the next poll().
+    // Returns false if its frame could not be allocated or all slots are in use.
+    bool spawn(CoTask task);
+
+    // Resumes every ready task once. Finished tasks are destroyed and their slots freed.
+    void poll();
+
+    // Number of tasks that are still running.
+    uint8_t activeCount() const;
+
+  private:
+    std::coroutine_handle<CoTask::promise_type> tasks[COTASK_FRAME_SLOTS];
+};
+
+#endif // FUZZY_COROUTINES
+
+#endif // End of include guard
@@ -0,0 +1,33 @@
+// ControlFrame.h
+#ifndef ControlFrame_h // Include guard to prevent multiple inclusions
+#define ControlFrame_h
+
+#include <Arduino.h>
+
+// Rule grid: every combination of the 3 temperature x 3 humidity x 3 soil moisture sets.
+// Cell index = (temperature set * 3 + humidity set) * 3 + soil set, sets ordered low to high.
+const uint8_t RULE_GRID_LEVELS = 3;
+const uint8_t RULE_GRID_CELLS = RULE_GRID_LEVELS * RULE_GRID_LEVELS * RULE_GRID_LEVELS;
+
+// Membership degrees: every set of the 3 inputs. Index = input * 3 + set, inputs ordered
+// temperature, humidity, soil moisture.
+const uint8_t MEMBERSHIP_INPUTS = 3;
+const uint8_t MEMBERSHIP_CELLS = MEMBERSHIP_INPUTS * RULE_GRID_LEVELS;
+const uint8_t MEMBERSHIP_UNKNOWN = 0xFF; // No valid inference
+
+// One complete result of the control pipeline, handed from the acquisition/inference
+// side to the rendering/logging side.
+struct ControlFrame {
+  float temperature;   // Temperature used for this inference (NAN if not yet valid)
+  float humidity;      // Humidity used for this inference (NAN if not yet valid)
+  float soilMoisture;  // Soil moisture used for this inference (NAN if not yet valid)
+  float pumpPower;     // Defuzzified pump power (0-100)
+  bool inputsValid;    // True if all three inputs were valid and pumpPower is fresh
+  unsigned long sampleMicros; // micros() of the most recent sensor read feeding this frame
+  unsigned long inferenceMicros; // Time runInference() took, 0 if !inputsValid
+  uint32_t modelVersion; // ModelSlot version (model swaps so far) inference ran on
+  uint8_t ruleFiring[RULE_GRID_CELLS]; // Firing strength of each rule grid cell (0-255), all 0 if !inputsValid
+  uint8_t memberships[MEMBERSHIP_CELLS]; // Membership degree of each input set in hundredths (0-100), MEMBERSHIP_UNKNOWN if !inputsValid
+};
+
+#endif // End of include guard
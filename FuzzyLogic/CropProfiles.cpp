@@ -0,0 +1,86 @@
+// CropProfiles.cpp
+#include "CropProfiles.h" // Include the header file we just defined
+
+// Sets are trapezoids (a, b, c, d) over the same ranges as DEFAULT_MODEL; rules name a set
+// level per input (temperature, humidity, soil moisture), RULE_ANY to leave one out.
+
+// TOMATO_MODEL definition
+const ModelBlob TOMATO_MODEL = {
+  MODEL_BLOB_MAGIC, MODEL_BLOB_VERSION, 0, sizeof(ModelBlob),
+  {
+    {
+      {{-5, -5, 12, 18}, {12, 18, 26, 32}, {26, 32, 45, 45}},     // Temperature: low, medium, high
+      {{0, 0, 35, 55}, {35, 55, 55, 75}, {55, 75, 100, 100}},     // Humidity: low, medium, high
+      {{0, 0, 30, 45}, {30, 45, 55, 70}, {55, 70, 100, 100}}      // Soil moisture: dry, moist, wet
+    },
+    {{0, 0, 0, 15}, {0, 15, 15, 40}, {15, 40, 40, 60}, {40, 60, 100, 100}}, // Pump power: none, low, moderate, full
+    {
+      {{RULE_ANY, RULE_ANY, SET_WET}, WATER_NONE},         // Wet soil: never
+      {{SET_LOW, RULE_ANY, SET_MOIST}, WATER_NONE},        // Cold: only dry soil is watered, a little
+      {{SET_LOW, RULE_ANY, SET_DRY}, WATER_LOW},
+      {{SET_MEDIUM, RULE_ANY, SET_DRY}, WATER_FULL},       // Mild and dry: fruit set needs water
+      {{SET_MEDIUM, SET_LOW, SET_MOIST}, WATER_MODERATE},
+      {{SET_MEDIUM, SET_MEDIUM, SET_MOIST}, WATER_MODERATE},
+      {{SET_MEDIUM, SET_HIGH, SET_MOIST}, WATER_LOW},      // Humid air: less, against leaf disease
+      {{SET_HIGH, RULE_ANY, SET_DRY}, WATER_FULL},
+      {{SET_HIGH, RULE_ANY, SET_MOIST}, WATER_MODERATE},
+      {{SET_HIGH, SET_LOW, SET_MOIST}, WATER_FULL}         // Hot and dry air
+    },
+    10 // Number of rules above
+  },
+  {}, // No output table
+  0   // Not sealed
+};
+
+// SUCCULENT_MODEL definition
+const ModelBlob SUCCULENT_MODEL = {
+  MODEL_BLOB_MAGIC, MODEL_BLOB_VERSION, 0, sizeof(ModelBlob),
+  {
+    {
+      {{-5, -5, 10, 20}, {10, 20, 20, 30}, {20, 30, 45, 45}},     // Temperature: low, medium, high
+      {{0, 0, 30, 50}, {30, 50, 50, 70}, {50, 70, 100, 100}},     // Humidity: low, medium, high
+      {{0, 0, 8, 18}, {8, 18, 25, 40}, {25, 40, 100, 100}}        // Soil moisture: dry, moist, wet
+    },
+    {{0, 0, 0, 20}, {0, 15, 15, 35}, {15, 35, 35, 55}, {35, 55, 100, 100}}, // Pump power: none, low, moderate, full
+    {
+      {{RULE_ANY, RULE_ANY, SET_WET}, WATER_NONE},
+      {{RULE_ANY, RULE_ANY, SET_MOIST}, WATER_NONE},       // Only nearly dry soil is watered
+      {{SET_LOW, RULE_ANY, RULE_ANY}, WATER_NONE},         // Dormant in the cold
+      {{RULE_ANY, SET_HIGH, RULE_ANY}, WATER_NONE},        // Humid air: roots rot
+      {{SET_MEDIUM, SET_LOW, SET_DRY}, WATER_MODERATE},
+      {{SET_MEDIUM, SET_MEDIUM, SET_DRY}, WATER_LOW},
+      {{SET_HIGH, SET_LOW, SET_DRY}, WATER_MODERATE},
+      {{SET_HIGH, SET_MEDIUM, SET_DRY}, WATER_MODERATE}
+    },
+    8 // Number of rules above
+  },
+  {}, // No output table
+  0   // Not sealed
+};
+
+// SEEDLING_MODEL definition
+const ModelBlob SEEDLING_MODEL = {
+  MODEL_BLOB_MAGIC, MODEL_BLOB_VERSION, 0, sizeof(ModelBlob),
+  {
+    {
+      {{-5, -5, 14, 20}, {14, 20, 24, 30}, {24, 30, 45, 45}},     // Temperature: low, medium, high
+      {{0, 0, 30, 50}, {30, 50, 50, 70}, {50, 70, 100, 100}},     // Humidity: low, medium, high
+      {{0, 0, 35, 50}, {35, 50, 55, 70}, {55, 70, 100, 100}}      // Soil moisture: dry, moist, wet
+    },
+    {{0, 0, 0, 10}, {0, 10, 10, 25}, {10, 25, 25, 40}, {25, 40, 100, 100}}, // Pump power: none, low, moderate, full
+    {
+      {{RULE_ANY, RULE_ANY, SET_WET}, WATER_NONE},
+      {{RULE_ANY, SET_HIGH, SET_MOIST}, WATER_NONE},
+      {{RULE_ANY, SET_LOW, SET_MOIST}, WATER_LOW},         // Top up before the soil dries out
+      {{RULE_ANY, SET_MEDIUM, SET_MOIST}, WATER_LOW},
+      {{SET_LOW, RULE_ANY, SET_DRY}, WATER_LOW},
+      {{SET_MEDIUM, RULE_ANY, SET_DRY}, WATER_MODERATE},
+      {{SET_HIGH, RULE_ANY, SET_DRY}, WATER_MODERATE},
+      {{SET_HIGH, SET_LOW, SET_DRY}, WATER_FULL},          // Hot, dry air and dry soil
+      {{SET_HIGH, SET_LOW, SET_MOIST}, WATER_MODERATE}
+    },
+    9 // Number of rules above
+  },
+  {}, // No output table
+  0   // Not sealed
+};
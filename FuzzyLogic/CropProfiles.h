@@ -0,0 +1,25 @@
+// CropProfiles.h
+#ifndef CropProfiles_h // Include guard to prevent multiple inclusions
+#define CropProfiles_h
+
+#include "ModelBlob.h"
+
+// Controller profiles for the crops grown on this hardware, next to the general-purpose
+// DEFAULT_MODEL of the sketch. Each is a constant ModelBlob: it is placed in flash with
+// the program and inference reads it there, so a profile costs no RAM and switching to
+// one is a pointer swap (ModelSlot). Like DEFAULT_MODEL they carry no output table and
+// no checksum; setup() checks them with validateModel().
+
+// Tomatoes: thirsty in warm weather, soil kept between 30 and 60 percent, full watering
+// whenever it is warm and dry.
+extern const ModelBlob TOMATO_MODEL;
+
+// Succulents: watered only when the soil is nearly dry (below about 15 percent) and it is
+// not cold or humid, never more than moderately.
+extern const ModelBlob SUCCULENT_MODEL;
+
+// Seedlings: soil kept evenly moist (about 40 to 60 percent) with small, frequent
+// waterings; full power only when hot, dry air meets dry soil.
+extern const ModelBlob SEEDLING_MODEL;
+
+#endif // End of include guard
@@ -0,0 +1,78 @@
+// DhtCapture.cpp
+#include "DhtCapture.h" // Include the header file we just defined
+
+DhtCapture* DhtCapture::active = NULL;
+
+// Constructor implementation
+DhtCapture::DhtCapture(uint8_t pin) :
+  pin(pin),
+  edgeCount(0) {
+}
+
+// beginStart method implementation
+void DhtCapture::beginStart() {
+  pinMode(pin, OUTPUT);
+  digitalWrite(pin, LOW); // DHT22 needs the line low for at least 1 ms
+}
+
+// beginCapture method implementation
+void DhtCapture::beginCapture() {
+  edgeCount = 0;
+  active = this;
+  // Arm the interrupt before releasing the line: the sensor answers within 20-40 us.
+  attachInterrupt(digitalPinToInterrupt(pin), handleEdge, FALLING);
+  pinMode(pin, INPUT_PULLUP);
+}
+
+// isComplete method implementation
+bool DhtCapture::isComplete() const {
+  return edgeCount >= EDGES_PER_RESPONSE;
+}
+
+// isCompleteCallback method implementation
+bool DhtCapture::isCompleteCallback(void* context) {
+  return static_cast<DhtCapture*>(context)->isComplete();
+}
+
+// handleEdge method implementation (interrupt context: only timestamps the edge)
+void IRAM_ATTR DhtCapture::handleEdge() {
+  DhtCapture* capture = active;
+  if (capture != NULL && capture->edgeCount < MAX_EDGES) {
+    capture->edgeMicros[capture->edgeCount] = micros();
+    capture->edgeCount = capture->edgeCount + 1;
+  }
+}
+
+// decode method implementation
+bool DhtCapture::decode(float& temp, float& humid) {
+  detachInterrupt(digitalPinToInterrupt(pin));
+  active = NULL;
+
+  uint8_t count = edgeCount;
+  if (count < EDGES_PER_RESPONSE) {
+    return false; // Sensor missing or response cut short
+  }
+
+  // Work back from the last edge so that spurious edges before the response are ignored.
+  // Bit i spans from the falling edge that starts its low phase to the next falling edge.
+  uint8_t first = count - (EDGES_PER_RESPONSE - 1); // Falling edge starting bit 0
+  uint8_t data[5] = {0, 0, 0, 0, 0};
+  for (uint8_t i = 0; i < 40; i++) {
+    unsigned long period = edgeMicros[first + i + 1] - edgeMicros[first + i];
+    data[i / 8] <<= 1;
+    if (period > ONE_BIT_MICROS) {
+      data[i / 8] |= 1;
+    }
+  }
+
+  if ((uint8_t)(data[0] + data[1] + data[2] + data[3]) != data[4]) {
+    return false; // Checksum mismatch
+  }
+
+  humid = ((data[0] << 8) | data[1]) * 0.1;
+  temp = (((data[2] & 0x7F) << 8) | data[3]) * 0.1;
+  if (data[2] & 0x80) { // Sign bit
+    temp = -temp;
+  }
+  return true;
+}
@@ -0,0 +1,56 @@
+// DhtCapture.h
+#ifndef DhtCapture_h // Include guard to prevent multiple inclusions
+#define DhtCapture_h
+
+#include <Arduino.h>
+
+// Non-blocking DHT22 reader based on edge capture.
+// Instead of bit-banging the 40-bit response with interrupts disabled (as the DHT library
+// does for ~5 ms), the caller drives the start pulse, then a pin interrupt timestamps every
+// falling edge of the sensor's response. Once the edges are in, decode() turns the edge
+// spacing into the five data bytes. All waiting between the steps is left to the caller
+// (e.g. a coroutine), so nothing here ever busy-waits.
+//
+// Typical sequence:
+//   beginStart()              -> data line driven low
+//   ...wait >= 1 ms...
+//   beginCapture()            -> line released, edges recorded by the ISR
+//   ...wait until isComplete() or ~10 ms...
+//   decode(temp, humid)       -> true if the checksum matched
+//
+// Only one DhtCapture may be capturing at a time (the ISR uses a static instance pointer).
+class DhtCapture {
+  public:
+    // pin: DHT22 data pin (with pull-up).
+    explicit DhtCapture(uint8_t pin);
+
+    // Drives the data line low to request a reading (host start signal).
+    void beginStart();
+
+    // Arms the falling-edge interrupt and releases the data line so the sensor answers.
+    void beginCapture();
+
+    // True once every edge of a full response has been captured.
+    bool isComplete() const;
+
+    // Stops capturing and decodes the captured response.
+    // Returns false (and leaves temp/humid unchanged) on a short response or bad checksum.
+    bool decode(float& temp, float& humid);
+
+    // Adapter for waitUntil(): context is a DhtCapture*.
+    static bool isCompleteCallback(void* context);
+
+  private:
+    static const uint8_t EDGES_PER_RESPONSE = 42; // Response start + start of bit 0 + end of each of the 40 bits
+    static const uint8_t MAX_EDGES = 48;          // Room for a few spurious edges
+    static const unsigned long ONE_BIT_MICROS = 100; // Bit periods above this (50us low + 70us high) are 1s
+
+    static void handleEdge(); // Falling-edge ISR
+    static DhtCapture* active; // Instance currently capturing (used by the ISR)
+
+    uint8_t pin;
+    volatile uint8_t edgeCount;
+    volatile unsigned long edgeMicros[MAX_EDGES];
+};
+
+#endif // End of include guard
@@ -0,0 +1,100 @@
+// DigitAtlas.cpp
+#include "DigitAtlas.h" // Include the header file we just defined
+
+// Glyph order: digits, sign, decimal point, units, then the two special cells
+const char DigitAtlas::CHARSET[GLYPH_COUNT + 1] = "0123456789-.%C\x01\x02";
+
+// Drawing target used only by begin(): records the pixels Adafruit_GFX draws for one
+// character into a row-mask array, so the atlas matches tft.print() pixel for pixel.
+class GlyphRasterizer : public Adafruit_GFX {
+  public:
+    explicit GlyphRasterizer(uint16_t* rows) : Adafruit_GFX(12, 16), rows(rows) {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t) override {
+      if (x >= 0 && x < 12 && y >= 0 && y < 16) {
+        rows[y] |= 0x800 >> x;
+      }
+    }
+
+  private:
+    uint16_t* rows;
+};
+
+// Constructor implementation
+DigitAtlas::DigitAtlas() {
+  memset(masks, 0, sizeof(masks));
+}
+
+// begin method implementation
+void DigitAtlas::begin() {
+  memset(masks, 0, sizeof(masks));
+  for (uint8_t size = 1; size <= 2; size++) {
+    for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+      uint16_t* rows = masks[size - 1][i];
+      char c = CHARSET[i];
+      if (c == DEGREE) {
+        // 2x2 dot one pixel in from the left, on the top rows (scaled for size 2)
+        for (uint8_t y = 0; y < 2 * size; y++) {
+          for (uint8_t x = size; x < 3 * size; x++) {
+            rows[y] |= 0x800 >> x;
+          }
+        }
+      } else if (c != THIN_SPACE) {
+        GlyphRasterizer rasterizer(rows);
+        rasterizer.drawChar(0, 0, c, 1, 1, size); // Same fg/bg: only the glyph pixels are drawn
+      }
+    }
+  }
+}
+
+// glyphIndex method implementation
+int8_t DigitAtlas::glyphIndex(char c) const {
+  for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+    if (CHARSET[i] == c) return i;
+  }
+  return -1;
+}
+
+// glyphWidth method implementation
+uint8_t DigitAtlas::glyphWidth(int8_t index, uint8_t size) const {
+  char c = index < 0 ? ' ' : CHARSET[index];
+  if (c == DEGREE) return 4 * size;
+  if (c == THIN_SPACE) return 2 * size;
+  return 6 * size; // 5 px glyph + 1 px spacing, like print()
+}
+
+// textWidth method implementation
+int16_t DigitAtlas::textWidth(const char* text, uint8_t size) const {
+  int16_t width = 0;
+  for (; *text; text++) {
+    width += glyphWidth(glyphIndex(*text), size);
+  }
+  return width;
+}
+
+// render method implementation
+void DigitAtlas::render(const char* text, uint8_t size, uint16_t fg, uint16_t bg, uint16_t* block, int16_t blockWidth) const {
+  int16_t height = 8 * size;
+  for (int32_t i = 0; i < (int32_t)blockWidth * height; i++) {
+    block[i] = bg;
+  }
+
+  int16_t x = 0;
+  for (; *text && x < blockWidth; text++) {
+    int8_t index = glyphIndex(*text);
+    uint8_t width = glyphWidth(index, size);
+    if (index >= 0) {
+      const uint16_t* rows = masks[size - 1][index];
+      for (int16_t y = 0; y < height; y++) {
+        uint16_t bits = rows[y];
+        uint16_t* out = &block[y * blockWidth + x];
+        for (uint8_t col = 0; col < width && x + col < blockWidth; col++) {
+          if (bits & (0x800 >> col)) {
+            out[col] = fg;
+          }
+        }
+      }
+    }
+    x += width;
+  }
+}
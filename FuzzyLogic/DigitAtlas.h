@@ -0,0 +1,49 @@
+// DigitAtlas.h
+#ifndef DigitAtlas_h // Include guard to prevent multiple inclusions
+#define DigitAtlas_h
+
+#include <Adafruit_GFX.h>
+
+// Pre-rasterized glyphs for the numeric fields of FuzzyDisplay.
+//
+// begin() renders the few characters a numeric field can contain (digits, sign, decimal
+// point, '%', 'C' and a small degree mark) once, at text size 1 and 2, from the same
+// built-in font Adafruit GFX uses for print(). render() then composes a whole field
+// (text plus background up to the field width) into a caller-provided RGB565 block,
+// which is sent to the panel as ONE rectangular transfer instead of a per-pixel
+// glyph draw for every character.
+//
+// Glyphs are kept as 1-bit row masks (16 rows of 12 bits per size); colors are applied
+// while composing the block, so one atlas serves every text color.
+class DigitAtlas {
+  public:
+    static const char DEGREE = '\x01';     // Small 2x2 degree mark (with spacing, 4 px wide at size 1)
+    static const char THIN_SPACE = '\x02'; // 2 px gap (used before '%')
+
+    DigitAtlas();
+
+    // Rasterizes all glyphs. Call once (FuzzyDisplay::begin()).
+    void begin();
+
+    // Width in pixels of text at the given size (1 or 2).
+    int16_t textWidth(const char* text, uint8_t size) const;
+
+    // Composes text into block (blockWidth x 8*size pixels, row-major): background bg,
+    // glyph pixels fg. Characters without a glyph are left blank; text beyond blockWidth
+    // is cut off.
+    void render(const char* text, uint8_t size, uint16_t fg, uint16_t bg, uint16_t* block, int16_t blockWidth) const;
+
+  private:
+    static const uint8_t GLYPH_COUNT = 16;
+    static const uint8_t MAX_ROWS = 16;
+
+    // Characters in the atlas, in glyph index order.
+    static const char CHARSET[GLYPH_COUNT + 1];
+
+    int8_t glyphIndex(char c) const;
+    uint8_t glyphWidth(int8_t index, uint8_t size) const;
+
+    uint16_t masks[2][GLYPH_COUNT][MAX_ROWS]; // [size-1][glyph][row], bit (11 - x) set for pixel x
+};
+
+#endif // End of include guard
@@ -0,0 +1,113 @@
+// DisplayWidget.h
+#ifndef DisplayWidget_h // Include guard to prevent multiple inclusions
+#define DisplayWidget_h
+
+#include <stdint.h>
+
+// Table-driven building blocks of the FuzzyDisplay pages.
+//
+// A page is a const array of Widget entries, each with its bounding box computed when
+// the table is compiled. FuzzyDisplay keeps one WidgetState per entry and renders a page
+// in a single pass: a widget is drawn only when it is dirty (page just shown) or when its
+// quantized key (what it would show) differs from the key already on screen. Adding a
+// field or a page is a table entry, not a new drawing code path.
+
+// What a widget draws.
+enum WidgetType : uint8_t {
+  WIDGET_LABEL,  // Static text, drawn once per page switch
+  WIDGET_FILL,   // Static solid rectangle (separator lines)
+  WIDGET_NUMBER, // Numeric field from the digit atlas, one block transfer per change
+  WIDGET_BAR,    // Bordered horizontal bar, only the changed strip is drawn
+  WIDGET_CHART,  // Soil/pump history chart, one column per new sample
+  WIDGET_HEAT,   // Heatmap cell: solid box colored by a rule firing strength
+  WIDGET_MEMBERSHIP // Membership function plot, only the input marker columns are redrawn
+};
+
+// Which live value a widget shows.
+enum WidgetSource : uint8_t {
+  SOURCE_NONE,
+  SOURCE_TEMPERATURE,
+  SOURCE_HUMIDITY,
+  SOURCE_SOIL,
+  SOURCE_PUMP,
+  SOURCE_HISTORY,
+  SOURCE_RULE_FIRING, // Rule grid cell given by Widget::index
+  SOURCE_MEMBERSHIP,  // Membership degree of the input set given by Widget::index
+  SOURCE_COUNT
+};
+
+// How a numeric field turns its value into text and color.
+enum WidgetFormat : uint8_t {
+  FORMAT_NONE,
+  FORMAT_TEMPERATURE, // "23.4°C", white
+  FORMAT_PERCENT,     // "45.6 %", white
+  FORMAT_PUMP,        // "42" / "42.5", blue / yellow / red by power band
+  FORMAT_DEGREE       // "0.65", in the widget's color
+};
+
+// One entry of a page table.
+struct Widget {
+  WidgetType type;
+  WidgetSource source;
+  WidgetFormat format;
+  uint8_t textSize;
+  uint8_t index;      // Element of a multi-valued source (rule grid cell, input set, plot)
+  int16_t x, y, w, h; // Bounding box: everything the widget draws stays inside it
+  uint16_t color;     // Text, fill or bar color (numeric fields may pick their own)
+  const char* text;   // Label text (labels only)
+};
+
+// Runtime state of one widget on the current page.
+struct WidgetState {
+  int32_t key;        // Quantized content currently on screen
+  bool dirty;         // Must be drawn completely on the next render pass
+};
+
+// Character count of a label, at compile time.
+constexpr int16_t widgetTextLength(const char* text) {
+  return *text ? 1 + widgetTextLength(text + 1) : 0;
+}
+
+// Static text in the built-in 6x8 font; the box is sized from the text.
+constexpr Widget labelWidget(int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size = 1) {
+  return Widget{WIDGET_LABEL, SOURCE_NONE, FORMAT_NONE, size, 0,
+                x, y, (int16_t)(widgetTextLength(text) * 6 * size), (int16_t)(8 * size), color, text};
+}
+
+// Solid rectangle.
+constexpr Widget fillWidget(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  return Widget{WIDGET_FILL, SOURCE_NONE, FORMAT_NONE, 1, 0, x, y, w, h, color, nullptr};
+}
+
+// Numeric field: width is the space cleared behind the text (widest value it can show).
+constexpr Widget numberWidget(int16_t x, int16_t y, int16_t width, WidgetSource source,
+                              WidgetFormat format, uint8_t size = 1) {
+  return Widget{WIDGET_NUMBER, source, format, size, 0, x, y, width, (int16_t)(8 * size), 0xFFFF, nullptr};
+}
+
+// Bar of 0-100 %, with a 1 px border inside the box.
+constexpr Widget barWidget(int16_t x, int16_t y, int16_t w, int16_t h, WidgetSource source, uint16_t color) {
+  return Widget{WIDGET_BAR, source, FORMAT_NONE, 1, 0, x, y, w, h, color, nullptr};
+}
+
+// History chart, one column per sample.
+constexpr Widget chartWidget(int16_t x, int16_t y, int16_t w, int16_t h) {
+  return Widget{WIDGET_CHART, SOURCE_HISTORY, FORMAT_NONE, 1, 0, x, y, w, h, 0, nullptr};
+}
+
+// One cell of the rule firing heatmap.
+constexpr Widget heatWidget(int16_t x, int16_t y, int16_t size, uint8_t cell) {
+  return Widget{WIDGET_HEAT, SOURCE_RULE_FIRING, FORMAT_NONE, 1, cell, x, y, size, size, 0, nullptr};
+}
+
+// Membership degree of one input set (index = input * 3 + set), "0.00" to "1.00".
+constexpr Widget degreeWidget(int16_t x, int16_t y, uint8_t cell, uint16_t color) {
+  return Widget{WIDGET_NUMBER, SOURCE_MEMBERSHIP, FORMAT_DEGREE, 1, cell, x, y, 24, 8, color, nullptr};
+}
+
+// Membership function plot of one input, with a marker at the input's current value.
+constexpr Widget membershipWidget(int16_t x, int16_t y, int16_t w, int16_t h, WidgetSource source, uint8_t input) {
+  return Widget{WIDGET_MEMBERSHIP, source, FORMAT_NONE, 1, input, x, y, w, h, 0, nullptr};
+}
+
+#endif // End of include guard
@@ -0,0 +1,206 @@
+// DmaFlusher.cpp
+#include "DmaFlusher.h" // Include the header file we just defined
+
+#if FUZZY_DMA_FLUSH
+
+#include <SPI.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+
+// t->user bits
+static const uintptr_t USER_DC_DATA = 0x01; // DC high (data) for this transaction
+static const uintptr_t USER_LAST = 0x02;    // Last transaction of the flush
+
+DmaFlusher* DmaFlusher::instance = NULL;
+int8_t DmaFlusher::dcPin = -1;
+
+// Constructor implementation
+DmaFlusher::DmaFlusher() :
+  device(NULL),
+  queued(0),
+  staging(NULL),
+  xOffset(0),
+  yOffset(0),
+  busy(false),
+  callback(NULL),
+  callbackContext(NULL) {
+}
+
+// begin method implementation
+bool DmaFlusher::begin(St7735Panel& panel) {
+  xOffset = panel.xOffset();
+  yOffset = panel.yOffset();
+  dcPin = panel.dcPin();
+  instance = this;
+
+  // Full-screen staging buffer, allocated once from DMA-capable RAM
+  staging = (uint16_t*)heap_caps_malloc(STAGING_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA);
+  if (staging == NULL) {
+    return false;
+  }
+
+  SPI.end(); // Release the bus from the Arduino driver
+
+  spi_bus_config_t bus = {};
+  bus.mosi_io_num = TFT_MOSI_PIN;
+  bus.miso_io_num = -1;
+  bus.sclk_io_num = TFT_SCLK_PIN;
+  bus.quadwp_io_num = -1;
+  bus.quadhd_io_num = -1;
+  bus.max_transfer_sz = STAGING_PIXELS * sizeof(uint16_t);
+  if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+    SPI.begin(); // Give the bus back so the caller can fall back to blocking flushes
+    return false;
+  }
+
+  spi_device_interface_config_t dev = {};
+  dev.clock_speed_hz = TFT_SPI_HZ;
+  dev.mode = 0;
+  dev.spics_io_num = panel.csPin();
+  dev.queue_size = MAX_TRANSACTIONS;
+  dev.pre_cb = preTransfer;
+  dev.post_cb = postTransfer;
+  if (spi_bus_add_device(SPI3_HOST, &dev, &device) != ESP_OK) {
+    device = NULL;
+    spi_bus_free(SPI3_HOST);
+    SPI.begin();
+    return false;
+  }
+  return true;
+}
+
+// setCompletionCallback method implementation
+void DmaFlusher::setCompletionCallback(CompletionCallback callback, void* context) {
+  this->callback = callback;
+  this->callbackContext = context;
+}
+
+// preTransfer method implementation: set DC before the transaction is clocked out
+void IRAM_ATTR DmaFlusher::preTransfer(spi_transaction_t* t) {
+  gpio_set_level((gpio_num_t)dcPin, ((uintptr_t)t->user & USER_DC_DATA) ? 1 : 0);
+}
+
+// postTransfer method implementation: report completion after the last transaction
+void IRAM_ATTR DmaFlusher::postTransfer(spi_transaction_t* t) {
+  if (((uintptr_t)t->user & USER_LAST) && instance != NULL) {
+    instance->busy = false;
+    if (instance->callback != NULL) {
+      instance->callback(instance->callbackContext);
+    }
+  }
+}
+
+// waitIdle method implementation: collect every transaction of the previous flush
+void DmaFlusher::waitIdle() {
+  spi_transaction_t* done;
+  while (queued > 0) {
+    spi_device_get_trans_result(device, &done, portMAX_DELAY);
+    queued--;
+  }
+}
+
+// queueCommand method implementation: command byte (DC low) plus up to 4 data bytes (DC high)
+void DmaFlusher::queueCommand(uint8_t command, const uint8_t* data, uint8_t length) {
+  spi_transaction_t& cmd = transactions[queued];
+  cmd = {};
+  cmd.flags = SPI_TRANS_USE_TXDATA;
+  cmd.length = 8;
+  cmd.tx_data[0] = command;
+  cmd.user = (void*)0;
+  spi_device_queue_trans(device, &cmd, portMAX_DELAY);
+  queued++;
+
+  if (length > 0) {
+    spi_transaction_t& param = transactions[queued];
+    param = {};
+    param.flags = SPI_TRANS_USE_TXDATA;
+    param.length = length * 8;
+    memcpy(param.tx_data, data, length);
+    param.user = (void*)USER_DC_DATA;
+    spi_device_queue_trans(device, &param, portMAX_DELAY);
+    queued++;
+  }
+}
+
+// queuePixels method implementation: one DMA transaction for a whole rectangle
+void DmaFlusher::queuePixels(const uint16_t* staged, uint32_t count, bool last) {
+  spi_transaction_t& pixels = transactions[queued];
+  pixels = {};
+  pixels.length = count * 16;
+  pixels.tx_buffer = staged;
+  pixels.user = (void*)(USER_DC_DATA | (last ? USER_LAST : 0));
+  spi_device_queue_trans(device, &pixels, portMAX_DELAY);
+  queued++;
+}
+
+// stageRect method implementation: copies a rectangle into the staging buffer, byte-swapped
+uint32_t DmaFlusher::stageRect(FrameBuffer& fb, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t* out) {
+  const uint16_t* pixels = fb.getBuffer();
+  for (int16_t row = y; row < y + h; row++) {
+    const uint16_t* line = &pixels[row * FrameBuffer::FB_WIDTH + x];
+    for (int16_t col = 0; col < w; col++) {
+      uint16_t color = line[col];
+      *out++ = (color >> 8) | (color << 8); // The panel expects the high byte first
+    }
+  }
+  return (uint32_t)w * h;
+}
+
+// queueRect method implementation: address window + RAMWR + pixel burst
+void DmaFlusher::queueRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* staged, bool last) {
+  uint16_t x0 = x + xOffset, x1 = x0 + w - 1;
+  uint16_t y0 = y + yOffset, y1 = y0 + h - 1;
+  uint8_t columns[4] = {(uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1};
+  uint8_t rows[4] = {(uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1};
+  queueCommand(ST77XX_CASET, columns, 4);
+  queueCommand(ST77XX_RASET, rows, 4);
+  queueCommand(ST77XX_RAMWR, NULL, 0);
+  queuePixels(staged, (uint32_t)w * h, last);
+}
+
+// flushAsync method implementation
+FlushStats DmaFlusher::flushAsync(FrameBuffer& fb) {
+  FlushStats stats = {0, 0, 0};
+  uint8_t count = fb.dirtyRectCount();
+  if (count == 0 || device == NULL) {
+    return stats;
+  }
+
+  waitIdle(); // The previous frame must be out before its staging buffer is reused
+
+  // The dirty rectangles may overlap, so their total can exceed the staging buffer.
+  // In that (rare) case send their bounding box instead.
+  int16_t x, y, w, h;
+  uint32_t total = 0;
+  int16_t bx0 = FrameBuffer::FB_WIDTH, by0 = FrameBuffer::FB_HEIGHT, bx1 = 0, by1 = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    fb.dirtyRect(i, x, y, w, h);
+    total += (uint32_t)w * h;
+    bx0 = min(bx0, x); by0 = min(by0, y);
+    bx1 = max(bx1, (int16_t)(x + w)); by1 = max(by1, (int16_t)(y + h));
+  }
+
+  busy = true;
+  if (total > STAGING_PIXELS) {
+    stageRect(fb, bx0, by0, bx1 - bx0, by1 - by0, staging);
+    queueRect(bx0, by0, bx1 - bx0, by1 - by0, staging, true);
+    stats.transactions = 1;
+    stats.pixels = (uint32_t)(bx1 - bx0) * (by1 - by0);
+  } else {
+    uint16_t* out = staging;
+    for (uint8_t i = 0; i < count; i++) {
+      fb.dirtyRect(i, x, y, w, h);
+      uint32_t staged = stageRect(fb, x, y, w, h, out);
+      queueRect(x, y, w, h, out, i == count - 1);
+      out += staged;
+      stats.transactions++;
+      stats.pixels += staged;
+    }
+  }
+  fb.clearDirty();
+
+  stats.bytes = stats.pixels * 2 + stats.transactions * 11; // CASET(1+4) + RASET(1+4) + RAMWR(1)
+  return stats;
+}
+
+#endif // FUZZY_DMA_FLUSH
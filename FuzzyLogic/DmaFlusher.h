@@ -0,0 +1,87 @@
+// DmaFlusher.h
+#ifndef DmaFlusher_h // Include guard to prevent multiple inclusions
+#define DmaFlusher_h
+
+#include "FuzzyConfig.h"
+
+#if FUZZY_DMA_FLUSH
+
+#include <driver/spi_master.h>
+#include "FrameBuffer.h"
+#include "St7735Panel.h"
+
+#ifndef TFT_MOSI_PIN
+#define TFT_MOSI_PIN 23 // VSPI MOSI (default wiring, see README)
+#endif
+#ifndef TFT_SCLK_PIN
+#define TFT_SCLK_PIN 18 // VSPI SCLK
+#endif
+#ifndef TFT_SPI_HZ
+#define TFT_SPI_HZ 27000000 // ST7735 write clock
+#endif
+
+// Asynchronous framebuffer flush for the ST7735 on ESP32.
+// begin() takes the SPI bus over from the Arduino SPI driver and re-registers the panel
+// with the ESP-IDF spi_master driver using DMA. flushAsync() copies each dirty rectangle
+// of the framebuffer into a DMA staging buffer (in the panel's big-endian byte order),
+// queues the address window and pixel transactions, and returns without waiting for the
+// transfer. The CPU is only busy for the copy, never for the SPI clocking.
+//
+// Ordering guarantee: flushAsync() first waits for the previous flush to finish, so at
+// most one frame is in flight and the staging buffer is never overwritten mid-transfer.
+// The framebuffer itself can be drawn into again as soon as flushAsync() returns.
+class DmaFlusher {
+  public:
+    // Called in interrupt context when the last transaction of a flush has been sent.
+    typedef void (*CompletionCallback)(void* context);
+
+    DmaFlusher();
+
+    // Hands the SPI bus to the DMA driver. Call once after the panel is initialized
+    // and rotated; the Adafruit library must not send anything afterwards.
+    // Returns false if the bus, device or staging buffer could not be set up.
+    bool begin(St7735Panel& panel);
+
+    // Queues the dirty rectangles of fb and clears its dirty list. Waits only if the
+    // previous flush is still running. Returns the traffic queued.
+    FlushStats flushAsync(FrameBuffer& fb);
+
+    // Blocks until the last queued flush has been sent.
+    void waitIdle();
+
+    // True while a flush is being transferred.
+    bool isBusy() const { return busy; }
+
+    // Sets a function called (from the SPI interrupt) when each flush completes.
+    void setCompletionCallback(CompletionCallback callback, void* context);
+
+  private:
+    static const uint8_t TRANSACTIONS_PER_RECT = 6; // CASET, data, RASET, data, RAMWR, pixels
+    static const uint8_t MAX_TRANSACTIONS = FrameBuffer::MAX_DIRTY_RECTS * TRANSACTIONS_PER_RECT;
+    static const uint32_t STAGING_PIXELS = FrameBuffer::FB_WIDTH * FrameBuffer::FB_HEIGHT;
+
+    // spi_master callbacks (interrupt context); the DC level and "last" flag travel in t->user
+    static void IRAM_ATTR preTransfer(spi_transaction_t* t);
+    static void IRAM_ATTR postTransfer(spi_transaction_t* t);
+
+    void queueCommand(uint8_t command, const uint8_t* data, uint8_t length);
+    void queuePixels(const uint16_t* staged, uint32_t count, bool last);
+    uint32_t stageRect(FrameBuffer& fb, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t* out);
+    void queueRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* staged, bool last);
+
+    static DmaFlusher* instance; // For the interrupt callbacks
+    static int8_t dcPin;
+
+    spi_device_handle_t device;
+    spi_transaction_t transactions[MAX_TRANSACTIONS];
+    uint8_t queued;            // Transactions queued by the current flush, not yet collected
+    uint16_t* staging;         // DMA-capable copy of the pixels being sent
+    int16_t xOffset, yOffset;  // Panel RAM offsets for the current rotation
+    volatile bool busy;
+    CompletionCallback callback;
+    void* callbackContext;
+};
+
+#endif // FUZZY_DMA_FLUSH
+
+#endif // End of include guard
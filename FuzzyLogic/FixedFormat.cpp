@@ -0,0 +1,108 @@
+// FixedFormat.cpp
+#include "FixedFormat.h" // Include the header file we just defined
+
+// toTenths function implementation
+int32_t toTenths(float value) {
+  if (isnan(value)) {
+    return TENTHS_NAN;
+  }
+  float scaled = value * 10.0f;
+  return (int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f); // Truncation toward zero completes the rounding
+}
+
+// toTenths16 function implementation
+int16_t toTenths16(float value) {
+  int32_t tenths = toTenths(value);
+  if (tenths == TENTHS_NAN || tenths <= INT16_MIN || tenths > INT16_MAX) {
+    return TENTHS16_NAN;
+  }
+  return (int16_t)tenths;
+}
+
+// formatInteger function implementation
+char* formatInteger(int32_t value, char* out) {
+  if (value < 0) {
+    *out++ = '-';
+    return formatUnsigned(0u - (uint32_t)value, out); // Also right for INT32_MIN
+  }
+  return formatUnsigned((uint32_t)value, out);
+}
+
+// formatUnsigned function implementation
+char* formatUnsigned(uint32_t value, char* out) {
+  // Digits are produced least significant first, then copied out in order
+  char digits[10];
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value != 0);
+  while (count > 0) {
+    *out++ = digits[--count];
+  }
+  *out = '\0';
+  return out;
+}
+
+// formatTenths function implementation
+char* formatTenths(int32_t tenths, char* out) {
+  if (tenths == TENTHS_NAN) {
+    return appendText("nan", out);
+  }
+  if (tenths < 0) {
+    *out++ = '-';
+    tenths = -tenths;
+  }
+  out = formatInteger(tenths / 10, out);
+  *out++ = '.';
+  *out++ = '0' + tenths % 10;
+  *out = '\0';
+  return out;
+}
+
+// appendText function implementation
+char* appendText(const char* text, char* out) {
+  while (*text) {
+    *out++ = *text++;
+  }
+  *out = '\0';
+  return out;
+}
+
+#if FUZZY_BENCHMARK
+// Print that throws the text away, so the benchmark doesn't measure the UART
+class DiscardPrint : public Print {
+  public:
+    DiscardPrint() : characters(0) {}
+    size_t write(uint8_t c) override { characters++; return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { characters += size; return size; }
+    using Print::write;
+    uint32_t characters;
+};
+
+// Reading number i of the benchmark: spread over -40.0 .. 99.9 in tenths
+static float benchmarkReading(uint32_t i) {
+  return -40.0f + (float)(i * 37 % 1400) * 0.1f;
+}
+
+// benchmarkFormatting function implementation
+FormatBenchmark benchmarkFormatting(uint32_t iterations) {
+  FormatBenchmark result = {iterations, 0, 0};
+  DiscardPrint sink;
+  char text[16];
+
+  unsigned long start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    char* end = formatTenths(toTenths(benchmarkReading(i)), text);
+    sink.write((const uint8_t*)text, end - text); // Same sink as the Print path
+  }
+  result.fixedMicros = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    sink.print(benchmarkReading(i), 1);
+  }
+  result.printMicros = micros() - start;
+  return result;
+}
+#endif
@@ -0,0 +1,51 @@
+// FixedFormat.h
+#ifndef FixedFormat_h // Include guard to prevent multiple inclusions
+#define FixedFormat_h
+
+#include <Arduino.h>
+#include "FuzzyConfig.h"
+
+// Allocation-free number formatting shared by the display and the serial log.
+//
+// A reading is converted once to an integer number of tenths (toTenths()), then written
+// as text with integer arithmetic only. This replaces Print::print(float, 1), which
+// formats through double arithmetic one digit at a time. Every function writes into a
+// caller-provided buffer and returns a pointer to the terminating '\0', so a whole line
+// is built with a chain of calls and sent with ONE write.
+
+// Tenths value of NAN (no reading). formatTenths() writes it as "nan", like Print.
+const int32_t TENTHS_NAN = INT32_MIN;
+
+// Rounds value to tenths, half away from zero (what print(value, 1) shows), in float
+// arithmetic. NAN maps to TENTHS_NAN.
+int32_t toTenths(float value);
+
+// Same as toTenths(), narrowed to 16 bits for compact records: NAN and values outside
+// int16_t map to TENTHS16_NAN.
+const int16_t TENTHS16_NAN = INT16_MIN;
+int16_t toTenths16(float value);
+
+// Writes a decimal integer. Returns a pointer to the terminating '\0'.
+char* formatInteger(int32_t value, char* out);
+char* formatUnsigned(uint32_t value, char* out);
+
+// Writes tenths with one decimal place ("-12.3"). Returns a pointer to the terminating '\0'.
+char* formatTenths(int32_t tenths, char* out);
+
+// Copies text. Returns a pointer to the terminating '\0'.
+char* appendText(const char* text, char* out);
+
+#if FUZZY_BENCHMARK
+// Time to format the same readings with formatTenths() and with Print::print(float, 1)
+// into a sink that discards the text (so only the formatting is measured).
+struct FormatBenchmark {
+  uint32_t iterations;
+  unsigned long fixedMicros;
+  unsigned long printMicros;
+};
+
+// Formats iterations readings both ways and returns the totals.
+FormatBenchmark benchmarkFormatting(uint32_t iterations);
+#endif
+
+#endif // End of include guard
@@ -0,0 +1,262 @@
+// FlashLog.cpp
+#include "FlashLog.h" // Include the header file we just defined
+#include "ByteOrder.h"
+#include "Checksum.h"
+
+static const uint32_t SECTOR_MAGIC = 0x474F4C46; // "FLOG"
+static const uint16_t FREE_FIELD = 0xFFFF;       // Erased flash
+
+// Constructor implementation
+FlashLog::FlashLog(FlashStore& store) :
+  store(store),
+  sectorCount(0),
+  pagesPerSector(0),
+  currentSector(-1),
+  currentSequence(0),
+  nextPage(0),
+  boot(0),
+  encoder(),
+  stored(0),
+  pages(0),
+  erases(0),
+  maxErases(0) {
+}
+
+// begin method implementation
+bool FlashLog::begin() {
+  sectorCount = store.size() / store.sectorSize();
+  pagesPerSector = store.sectorSize() / PAGE_BYTES;
+  if (sectorCount < 2 || pagesPerSector < 2) {
+    sectorCount = 0; // Unusable: append() and forEach() do nothing
+    return false;
+  }
+
+  // Newest sector = highest sequence number
+  for (uint32_t sector = 0; sector < sectorCount; sector++) {
+    SectorHeader header;
+    if (!readHeader(sector, header)) continue;
+    if (header.eraseCount > maxErases) maxErases = header.eraseCount;
+    if (currentSector < 0 || header.sequence > currentSequence) {
+      currentSector = sector;
+      currentSequence = header.sequence;
+    }
+  }
+
+  uint16_t lastBoot = 0;
+  if (currentSector >= 0) {
+    // Count the samples of the current ring from the block headers
+    for (uint32_t sector = 0; sector < sectorCount; sector++) {
+      SectorHeader header;
+      if (!readHeader(sector, header) || header.sequence > currentSequence ||
+          currentSequence - header.sequence >= sectorCount) {
+        continue;
+      }
+      uint32_t records = 0, usedPages = 0;
+      countSector(sector, records, usedPages);
+      stored += records;
+      pages += usedPages;
+      if ((int32_t)sector == currentSector) {
+        nextPage = 1 + usedPages; // Used pages are never followed by a free one
+      }
+    }
+
+    // Newest sector still empty: the previous one is full, its last record is the latest
+    if (!findLastBoot(currentSector, nextPage, lastBoot)) {
+      uint32_t previous = (currentSector + sectorCount - 1) % sectorCount;
+      SectorHeader header;
+      if (readHeader(previous, header) && header.sequence + 1 == currentSequence) {
+        findLastBoot(previous, pagesPerSector, lastBoot);
+      }
+    }
+  }
+  boot = lastBoot + 1;
+  encoder.begin(block + BLOCK_HEADER_BYTES, PAGE_BYTES - BLOCK_HEADER_BYTES);
+  return true;
+}
+
+// capacityPages method implementation
+uint32_t FlashLog::capacityPages() const {
+  // One sector is always being refilled, so a full ring keeps the others
+  return sectorCount > 0 ? (sectorCount - 1) * (pagesPerSector - 1) : 0;
+}
+
+// append method implementation
+bool FlashLog::append(const FlashLogRecord& record) {
+  if (sectorCount == 0) {
+    return false;
+  }
+  if (encoder.add(record)) {
+    return true;
+  }
+  bool ok = writeBlock();
+  encoder.add(record); // Always fits an empty block
+  return ok;
+}
+
+// flush method implementation
+bool FlashLog::flush() {
+  return writeBlock();
+}
+
+// writeBlock method implementation
+bool FlashLog::writeBlock() {
+  if (encoder.count() == 0) {
+    return true;
+  }
+  bool ok = true;
+  if (currentSector < 0 || nextPage >= pagesPerSector) {
+    ok = openNextSector();
+  }
+  if (ok) {
+    uint16_t length = encoder.size();
+    putLe16(block, length);
+    putLe16(block + 2, encoder.count());
+    uint16_t crc = crc16Ccitt(block, 4);
+    putLe16(block + 4, crc16Ccitt(block + BLOCK_HEADER_BYTES, length, crc));
+    // One program operation; the rest of the page stays erased
+    ok = store.write(currentSector * store.sectorSize() + nextPage * PAGE_BYTES, block,
+                     BLOCK_HEADER_BYTES + length);
+    nextPage++; // Even after a failed write: the page may hold programmed bits now
+    if (ok) {
+      stored += encoder.count();
+      pages++;
+    }
+  }
+  // Records that could not be written are dropped, not retried forever
+  encoder.begin(block + BLOCK_HEADER_BYTES, PAGE_BYTES - BLOCK_HEADER_BYTES);
+  return ok;
+}
+
+// openNextSector method implementation
+bool FlashLog::openNextSector() {
+  uint32_t sector = currentSector < 0 ? 0 : (currentSector + 1) % sectorCount;
+  SectorHeader old;
+  bool wasStarted = readHeader(sector, old);
+  uint32_t eraseCount = (wasStarted ? old.eraseCount : 0) + 1; // Wear history survives the erase
+  if (wasStarted && currentSector >= 0 && old.sequence <= currentSequence &&
+      currentSequence - old.sequence < sectorCount) {
+    // The oldest records are about to go
+    uint32_t records = 0, usedPages = 0;
+    countSector(sector, records, usedPages);
+    stored -= min(stored, records);
+    pages -= min(pages, usedPages);
+  }
+
+  if (!store.eraseSector(sector * store.sectorSize())) {
+    return false;
+  }
+  erases++;
+  if (eraseCount > maxErases) maxErases = eraseCount;
+
+  uint8_t header[SECTOR_HEADER_BYTES];
+  uint32_t sequence = currentSector < 0 ? 1 : currentSequence + 1;
+  uint8_t* p = putLe32(header, SECTOR_MAGIC);
+  p = putLe32(p, sequence);
+  p = putLe32(p, eraseCount);
+  putLe32(p, ~(SECTOR_MAGIC ^ sequence ^ eraseCount));
+  if (!store.write(sector * store.sectorSize(), header, SECTOR_HEADER_BYTES)) {
+    return false;
+  }
+  currentSector = sector;
+  currentSequence = sequence;
+  nextPage = 1;
+  return true;
+}
+
+// readHeader method implementation
+bool FlashLog::readHeader(uint32_t sector, SectorHeader& header) {
+  uint8_t raw[SECTOR_HEADER_BYTES];
+  if (!store.read(sector * store.sectorSize(), raw, SECTOR_HEADER_BYTES)) {
+    return false;
+  }
+  uint32_t magic = getLe32(raw);
+  header.sequence = getLe32(raw + 4);
+  header.eraseCount = getLe32(raw + 8);
+  return magic == SECTOR_MAGIC && getLe32(raw + 12) == ~(magic ^ header.sequence ^ header.eraseCount);
+}
+
+// readBlockCount method implementation
+bool FlashLog::readBlockCount(uint32_t sector, uint32_t page, uint16_t& count) {
+  uint8_t raw[BLOCK_HEADER_BYTES];
+  if (!store.read(sector * store.sectorSize() + page * PAGE_BYTES, raw, BLOCK_HEADER_BYTES)) {
+    return false;
+  }
+  uint16_t length = getLe16(raw);
+  count = getLe16(raw + 2);
+  if (length == FREE_FIELD && count == FREE_FIELD && getLe16(raw + 4) == FREE_FIELD) {
+    return false;
+  }
+  if (length > PAGE_BYTES - BLOCK_HEADER_BYTES || count > length) {
+    count = 0; // Torn header: every sample takes at least one byte
+  }
+  return true;
+}
+
+// countSector method implementation
+void FlashLog::countSector(uint32_t sector, uint32_t& records, uint32_t& usedPages) {
+  for (uint32_t page = 1; page < pagesPerSector; page++) {
+    uint16_t count;
+    if (!readBlockCount(sector, page, count)) break; // End of this sector's blocks
+    records += count;
+    usedPages++;
+  }
+}
+
+// readBlock method implementation
+bool FlashLog::readBlock(uint32_t sector, uint32_t page, uint8_t* out) {
+  if (!store.read(sector * store.sectorSize() + page * PAGE_BYTES, out, PAGE_BYTES)) {
+    return false;
+  }
+  uint16_t length = getLe16(out);
+  if (length > PAGE_BYTES - BLOCK_HEADER_BYTES) {
+    return false; // Free or torn
+  }
+  uint16_t crc = crc16Ccitt(out, 4);
+  return crc16Ccitt(out + BLOCK_HEADER_BYTES, length, crc) == getLe16(out + 4);
+}
+
+// findLastBoot method implementation
+bool FlashLog::findLastBoot(uint32_t sector, uint32_t endPage, uint16_t& lastBoot) {
+  for (uint32_t page = endPage - 1; page >= 1; page--) {
+    if (!readBlock(sector, page, block)) continue;
+    SeriesDecoder decoder(block + BLOCK_HEADER_BYTES, getLe16(block));
+    FlashLogRecord record;
+    bool found = false;
+    while (decoder.next(record)) {
+      lastBoot = record.boot;
+      found = true;
+    }
+    if (found) return true;
+  }
+  return false;
+}
+
+// forEach method implementation
+uint32_t FlashLog::forEach(Visitor visit, void* context) {
+  if (sectorCount == 0 || currentSector < 0) {
+    return 0;
+  }
+  uint32_t visited = 0;
+  uint8_t page[PAGE_BYTES]; // The RAM block may hold samples not written yet
+  // Oldest first: the sector after the newest one, around the ring
+  for (uint32_t i = 1; i <= sectorCount; i++) {
+    uint32_t sector = (currentSector + i) % sectorCount;
+    SectorHeader header;
+    if (!readHeader(sector, header) || header.sequence > currentSequence ||
+        currentSequence - header.sequence >= sectorCount) {
+      continue; // Never started, or left over from an older ring (e.g. a resized region)
+    }
+    for (uint32_t p = 1; p < pagesPerSector; p++) {
+      uint16_t count;
+      if (!readBlockCount(sector, p, count)) break; // End of this sector's blocks
+      if (!readBlock(sector, p, page)) continue;    // Torn or corrupted: skip the block
+      SeriesDecoder decoder(page + BLOCK_HEADER_BYTES, getLe16(page));
+      FlashLogRecord record;
+      while (decoder.next(record)) {
+        visit(record, context);
+        visited++;
+      }
+    }
+  }
+  return visited;
+}
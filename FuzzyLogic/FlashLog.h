@@ -0,0 +1,112 @@
+// FlashLog.h
+#ifndef FlashLog_h // Include guard to prevent multiple inclusions
+#define FlashLog_h
+
+#include <Arduino.h>
+#include "FlashStore.h"
+#include "SeriesCodec.h"
+
+// Append-only circular log of FlashLogRecords in a raw flash region.
+//
+// The region is used as a ring of sectors. The first page of each sector holds a 16-byte
+// header (magic, sector sequence number, erase count); the other pages hold one block of
+// compressed samples each (SeriesCodec.h), behind a 6-byte block header (payload length,
+// sample count, CRC-16). Blocks are appended to the newest sector. When it is full, the
+// sector after it (the oldest) is erased and becomes the newest, so every sector is
+// erased exactly once per trip around the ring and the wear is even. The erase count in
+// the headers shows it.
+//
+// Samples are compressed into a page-sized block in RAM, and the block is programmed when
+// the next sample doesn't fit, so the flash is written once per block instead of once per
+// sample. The price is that a reset loses the block in RAM; call flush() before a planned
+// restart.
+//
+// begin() finds the newest sector and the first free page by reading the headers, so
+// nothing but the log itself is stored. A block torn by a power loss fails its CRC and
+// is skipped by the reader.
+class FlashLog {
+  public:
+    static const uint16_t PAGE_BYTES = 256;        // Program unit: one block per page
+    static const uint8_t SECTOR_HEADER_BYTES = 16;
+    static const uint8_t BLOCK_HEADER_BYTES = 6;
+
+    explicit FlashLog(FlashStore& store);
+
+    // Mounts the log and starts a new boot number. False if the store has fewer than
+    // two sectors (nothing is logged then).
+    bool begin();
+
+    // Adds a record to the RAM block; a full block is written first. False if writing
+    // the full block failed.
+    bool append(const FlashLogRecord& record);
+
+    // Writes the records of the RAM block so far (even if the block is not full).
+    bool flush();
+
+    // Boot number given to the records of this run (one more than the last logged).
+    uint16_t bootNumber() const { return boot; }
+
+    // Records in flash, and records still in the RAM block.
+    uint32_t storedRecords() const { return stored; }
+    uint16_t pendingRecords() const { return encoder.count(); }
+
+    // Block pages in flash, and how many fit before the oldest are overwritten.
+    uint32_t storedPages() const { return pages; }
+    uint32_t capacityPages() const;
+
+    // Sector erases done since begin(), and the highest erase count of any sector.
+    uint32_t sessionErases() const { return erases; }
+    uint32_t maxEraseCount() const { return maxErases; }
+
+    // Calls visit for every valid record in flash, oldest first. Returns the number of
+    // records visited.
+    typedef void (*Visitor)(const FlashLogRecord& record, void* context);
+    uint32_t forEach(Visitor visit, void* context);
+
+  private:
+    struct SectorHeader {
+      uint32_t sequence;   // Increases by one for each newly started sector
+      uint32_t eraseCount; // Erases of this sector so far
+    };
+
+    // Reads a sector header. False if the sector is erased or was never started.
+    bool readHeader(uint32_t sector, SectorHeader& header);
+
+    // Erases the sector after the current one and starts it as the newest.
+    bool openNextSector();
+
+    // Programs the RAM block into the next free page and starts a new block.
+    bool writeBlock();
+
+    // Reads a block page into out (PAGE_BYTES). False if the page is free, torn or corrupted.
+    bool readBlock(uint32_t sector, uint32_t page, uint8_t* out);
+
+    // Sample count from a block header (0 if the header is damaged). False for a free page.
+    bool readBlockCount(uint32_t sector, uint32_t page, uint16_t& count);
+
+    // Samples and used pages of a started sector.
+    void countSector(uint32_t sector, uint32_t& records, uint32_t& usedPages);
+
+    // Boot number of the last valid record in the pages before endPage of a sector.
+    // Uses the RAM block as scratch space. False if the sector has no valid block.
+    bool findLastBoot(uint32_t sector, uint32_t endPage, uint16_t& lastBoot);
+
+    FlashStore& store;
+    uint32_t sectorCount;
+    uint32_t pagesPerSector;   // Including the header page
+
+    int32_t currentSector;     // Newest sector, -1 while the region is empty
+    uint32_t currentSequence;
+    uint32_t nextPage;         // First free page of the newest sector
+
+    uint16_t boot;
+    uint8_t block[PAGE_BYTES]; // Block header + the encoder's payload
+    SeriesEncoder encoder;
+
+    uint32_t stored;
+    uint32_t pages;
+    uint32_t erases;
+    uint32_t maxErases;
+};
+
+#endif // End of include guard
@@ -0,0 +1,59 @@
+// FlashStore.cpp
+#include "FlashStore.h" // Include the header file we just defined
+
+#if defined(ESP32)
+
+#include <esp_idf_version.h>
+
+// Constructor implementation
+PartitionFlash::PartitionFlash(const char* label) :
+  label(label),
+  partition(NULL),
+  mapped(NULL) {
+}
+
+// begin method implementation
+bool PartitionFlash::begin() {
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  return partition != NULL;
+}
+
+// size method implementation
+uint32_t PartitionFlash::size() const {
+  return partition ? partition->size : 0;
+}
+
+// read method implementation
+bool PartitionFlash::read(uint32_t address, void* data, size_t length) {
+  return partition && esp_partition_read(partition, address, data, length) == ESP_OK;
+}
+
+// write method implementation
+bool PartitionFlash::write(uint32_t address, const void* data, size_t length) {
+  return partition && esp_partition_write(partition, address, data, length) == ESP_OK;
+}
+
+// eraseSector method implementation
+bool PartitionFlash::eraseSector(uint32_t address) {
+  return partition && esp_partition_erase_range(partition, address, sectorSize()) == ESP_OK;
+}
+
+// map method implementation
+const void* PartitionFlash::map() {
+  if (partition == NULL || mapped != NULL) {
+    return mapped;
+  }
+  // Never unmapped: the handle is not kept
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t handle;
+  if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+#else
+  spi_flash_mmap_handle_t handle;
+  if (esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+#endif
+    mapped = NULL;
+  }
+  return mapped;
+}
+
+#endif // ESP32
@@ -0,0 +1,66 @@
+// FlashStore.h
+#ifndef FlashStore_h // Include guard to prevent multiple inclusions
+#define FlashStore_h
+
+#include <Arduino.h>
+
+// Raw NOR flash region used by FlashLog and the stored model (ModelBlob.h).
+//
+// Same rules as the real chip: erasing a sector sets all its bytes to 0xFF, and a write
+// can only clear bits (1 -> 0), so every byte is written once between two erases.
+// Implementations: PartitionFlash (an ESP32 data partition, below) and the file-backed
+// emulation of the host build (host/FileFlash.h).
+class FlashStore {
+  public:
+    virtual ~FlashStore() {}
+
+    // Region size in bytes (a multiple of sectorSize()).
+    virtual uint32_t size() const = 0;
+
+    // Erase unit in bytes.
+    virtual uint32_t sectorSize() const { return 4096; }
+
+    // Reads length bytes at address (relative to the region).
+    virtual bool read(uint32_t address, void* data, size_t length) = 0;
+
+    // Programs length bytes at address; the bytes must be erased (0xFF).
+    virtual bool write(uint32_t address, const void* data, size_t length) = 0;
+
+    // Erases the sector starting at address.
+    virtual bool eraseSector(uint32_t address) = 0;
+
+    // The whole region as read-only memory, so its contents can be used in place, or
+    // NULL if this store can't be mapped. Later writes show through the mapping.
+    virtual const void* map() { return NULL; }
+};
+
+#if defined(ESP32)
+
+#include <esp_partition.h>
+
+// An ESP32 flash data partition (see partitions.csv), accessed through esp_partition_*.
+// Erasing a 4 KB sector blocks the calling task for tens of milliseconds. map() maps the
+// partition into the data address space through the flash cache once and keeps it mapped.
+class PartitionFlash : public FlashStore {
+  public:
+    // label: partition name in the partition table.
+    explicit PartitionFlash(const char* label);
+
+    // Looks the partition up. False if the partition table has no such data partition.
+    bool begin();
+
+    uint32_t size() const override;
+    bool read(uint32_t address, void* data, size_t length) override;
+    bool write(uint32_t address, const void* data, size_t length) override;
+    bool eraseSector(uint32_t address) override;
+    const void* map() override;
+
+  private:
+    const char* label;
+    const esp_partition_t* partition;
+    const void* mapped;
+};
+
+#endif // ESP32
+
+#endif // End of include guard
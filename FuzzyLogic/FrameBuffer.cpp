@@ -0,0 +1,150 @@
+// FrameBuffer.cpp
+#include "FrameBuffer.h" // Include the header file we just defined
+
+// Constructor implementation
+FrameBuffer::FrameBuffer() :
+  Adafruit_GFX(FB_WIDTH, FB_HEIGHT),
+  dirtyCount(0) {
+  memset(pixels, 0, sizeof(pixels)); // Matches the panel after fillScreen(ST77XX_BLACK)
+}
+
+// drawPixel method implementation
+void FrameBuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= FB_WIDTH || y >= FB_HEIGHT) {
+    return;
+  }
+  pixels[y * FB_WIDTH + x] = color;
+  addDirty({x, y, (int16_t)(x + 1), (int16_t)(y + 1)});
+}
+
+// fillRect method implementation
+void FrameBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  // Clip to the buffer
+  int16_t x1 = x + w;
+  int16_t y1 = y + h;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x1 > FB_WIDTH) x1 = FB_WIDTH;
+  if (y1 > FB_HEIGHT) y1 = FB_HEIGHT;
+  if (x >= x1 || y >= y1) {
+    return;
+  }
+
+  for (int16_t row = y; row < y1; row++) {
+    uint16_t* line = &pixels[row * FB_WIDTH];
+    for (int16_t col = x; col < x1; col++) {
+      line[col] = color;
+    }
+  }
+  addDirty({x, y, x1, y1});
+}
+
+// drawFastHLine method implementation
+void FrameBuffer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+// drawFastVLine method implementation
+void FrameBuffer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+// fillScreen method implementation
+void FrameBuffer::fillScreen(uint16_t color) {
+  fillRect(0, 0, FB_WIDTH, FB_HEIGHT, color);
+}
+
+// drawBlock method implementation
+void FrameBuffer::drawBlock(int16_t x, int16_t y, const uint16_t* block, int16_t w, int16_t h) {
+  int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+  int16_t x1 = min((int16_t)(x + w), (int16_t)FB_WIDTH), y1 = min((int16_t)(y + h), (int16_t)FB_HEIGHT);
+  if (x0 >= x1 || y0 >= y1) {
+    return;
+  }
+  for (int16_t row = y0; row < y1; row++) {
+    memcpy(&pixels[row * FB_WIDTH + x0], &block[(row - y) * w + (x0 - x)], (x1 - x0) * sizeof(uint16_t));
+  }
+  addDirty({x0, y0, x1, y1});
+}
+
+// markDirty method implementation
+void FrameBuffer::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  addDirty({x, y, (int16_t)(x + w), (int16_t)(y + h)});
+}
+
+// dirtyRect method implementation
+void FrameBuffer::dirtyRect(uint8_t i, int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+  x = dirty[i].x0;
+  y = dirty[i].y0;
+  w = dirty[i].x1 - dirty[i].x0;
+  h = dirty[i].y1 - dirty[i].y0;
+}
+
+// unite method implementation: bounding box of two rectangles
+FrameBuffer::DirtyRect FrameBuffer::unite(const DirtyRect& a, const DirtyRect& b) {
+  DirtyRect r;
+  r.x0 = min(a.x0, b.x0);
+  r.y0 = min(a.y0, b.y0);
+  r.x1 = max(a.x1, b.x1);
+  r.y1 = max(a.y1, b.y1);
+  return r;
+}
+
+// addDirty method implementation
+// Merges the new rectangle with any existing one where sending the bounding box costs
+// no more than sending both separately, repeating until no merge applies. If the list
+// is still full, the cheapest merge is forced so the list never overflows.
+void FrameBuffer::addDirty(DirtyRect rect) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+      DirtyRect u = unite(dirty[i], rect);
+      if (area(u) <= area(dirty[i]) + area(rect) + RECT_OVERHEAD_PIXELS) {
+        rect = u;
+        dirty[i] = dirty[--dirtyCount]; // Remove i; the union is re-inserted below
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  if (dirtyCount == MAX_DIRTY_RECTS) {
+    uint8_t best = 0;
+    int32_t bestWaste = INT32_MAX;
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+      int32_t waste = area(unite(dirty[i], rect)) - area(dirty[i]) - area(rect);
+      if (waste < bestWaste) {
+        bestWaste = waste;
+        best = i;
+      }
+    }
+    rect = unite(dirty[best], rect);
+    dirty[best] = dirty[--dirtyCount];
+    addDirty(rect); // The grown rectangle may now swallow others
+    return;
+  }
+
+  dirty[dirtyCount++] = rect;
+}
+
+// flush method implementation
+FlushStats FrameBuffer::flush(Adafruit_SPITFT& tft) {
+  FlushStats stats = {0, 0, 0};
+  for (uint8_t i = 0; i < dirtyCount; i++) {
+    const DirtyRect& r = dirty[i];
+    int16_t w = r.x1 - r.x0;
+    tft.startWrite();
+    tft.setAddrWindow(r.x0, r.y0, w, r.y1 - r.y0); // One address window per rectangle...
+    for (int16_t row = r.y0; row < r.y1; row++) {
+      tft.writePixels(&pixels[row * FB_WIDTH + r.x0], w); // ...and its rows as one continuous RAMWR burst
+    }
+    tft.endWrite();
+
+    stats.transactions++;
+    stats.pixels += (uint32_t)area(r);
+  }
+  stats.bytes = stats.pixels * 2 + stats.transactions * 11; // CASET(1+4) + RASET(1+4) + RAMWR(1)
+  dirtyCount = 0;
+  return stats;
+}
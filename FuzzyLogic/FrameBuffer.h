@@ -0,0 +1,76 @@
+// FrameBuffer.h
+#ifndef FrameBuffer_h // Include guard to prevent multiple inclusions
+#define FrameBuffer_h
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_SPITFT.h>
+
+// Display traffic of one flush, for benchmarking.
+struct FlushStats {
+  uint16_t transactions; // SPI transactions (one per dirty rectangle)
+  uint32_t pixels;       // Pixels sent
+  uint32_t bytes;        // Bytes sent, including the address window commands
+};
+
+// Off-screen RGB565 framebuffer for a 160x128 (landscape) ST7735.
+// All Adafruit_GFX drawing happens in RAM; every drawing call records the area it
+// touched. Touched areas are coalesced into at most MAX_DIRTY_RECTS rectangles, and
+// flush() sends each rectangle with one address window and one continuous pixel burst.
+class FrameBuffer : public Adafruit_GFX {
+  public:
+    static const int16_t FB_WIDTH = 160;
+    static const int16_t FB_HEIGHT = 128;
+    static const uint8_t MAX_DIRTY_RECTS = 6;
+
+    FrameBuffer();
+
+    // Adafruit_GFX drawing primitives, implemented directly on the buffer
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+
+    // Copies a w x h block of RGB565 pixels (row-major) to (x, y), clipped to the buffer.
+    void drawBlock(int16_t x, int16_t y, const uint16_t* block, int16_t w, int16_t h);
+
+    // Sends every dirty rectangle to the panel and clears the dirty list.
+    // Returns the traffic of this flush.
+    FlushStats flush(Adafruit_SPITFT& tft);
+
+    // True if anything was drawn since the last flush.
+    bool isDirty() const { return dirtyCount > 0; }
+
+    // Direct access to the pixel rows (row-major, FB_WIDTH pixels per row).
+    uint16_t* getBuffer() { return pixels; }
+
+    // Marks a region as changed (used after writing to getBuffer() directly).
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    // Dirty rectangles for custom flush paths (e.g. DmaFlusher): count, the i-th rectangle,
+    // and clearing the list once they have been sent.
+    uint8_t dirtyRectCount() const { return dirtyCount; }
+    void dirtyRect(uint8_t i, int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+    void clearDirty() { dirtyCount = 0; }
+
+  protected:
+    // Dirty rectangle, half-open: [x0, x1) x [y0, y1)
+    struct DirtyRect {
+      int16_t x0, y0, x1, y1;
+    };
+
+    // Bytes of command overhead per rectangle (CASET + 4, RASET + 4, RAMWR), expressed in
+    // pixels: merging two rectangles is worth it if it wastes fewer pixels than this.
+    static const int32_t RECT_OVERHEAD_PIXELS = 6;
+
+    static int32_t area(const DirtyRect& r) { return (int32_t)(r.x1 - r.x0) * (r.y1 - r.y0); }
+    static DirtyRect unite(const DirtyRect& a, const DirtyRect& b);
+
+    void addDirty(DirtyRect rect);
+
+    uint16_t pixels[FB_WIDTH * FB_HEIGHT];
+    DirtyRect dirty[MAX_DIRTY_RECTS];
+    uint8_t dirtyCount;
+};
+
+#endif // End of include guard
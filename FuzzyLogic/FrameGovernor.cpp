@@ -0,0 +1,57 @@
+// FrameGovernor.cpp
+#include "FrameGovernor.h" // Include the header file we just defined
+
+// Constructor implementation
+FrameGovernor::FrameGovernor(unsigned long frameIntervalMillis, unsigned long budgetMillisPerSecond) :
+  updates(0),
+  seenUpdates(0),
+  frameInterval(frameIntervalMillis),
+  nextFrameMillis(0),
+  budgetPerSecond((int32_t)constrain(budgetMillisPerSecond, 1UL, 1000UL)),
+  creditMicros(budgetPerSecond * 1000), // Start with a full bucket
+  lastRefillMillis(0),
+  rendered(0),
+  skipped(0),
+  coalesced(0) {
+}
+
+// beginFrame method implementation
+bool FrameGovernor::beginFrame(unsigned long nowMillis) {
+  uint32_t published = updates.load(std::memory_order_acquire);
+  if (published == seenUpdates) {
+    return false; // Nothing new to show
+  }
+  if ((long)(nowMillis - nextFrameMillis) < 0) {
+    return false; // Not due yet: further updates coalesce into the next frame
+  }
+
+  refill(nowMillis);
+  if (creditMicros <= 0) {
+    // Over budget: skip this frame and retry once the bucket is positive again
+    // (but not before the next regular frame time)
+    unsigned long refillMillis = (unsigned long)(-creditMicros / budgetPerSecond) + 1;
+    nextFrameMillis = nowMillis + max(frameInterval, refillMillis);
+    skipped++;
+    return false;
+  }
+
+  coalesced += published - seenUpdates - 1; // Updates replaced before they were drawn
+  seenUpdates = published;
+  nextFrameMillis = nowMillis + frameInterval;
+  rendered++;
+  return true;
+}
+
+// endFrame method implementation
+void FrameGovernor::endFrame(unsigned long costMicros) {
+  // A single frame may overdraw the bucket; the following frames then wait longer
+  creditMicros -= (int32_t)min(costMicros, 1000000UL);
+}
+
+// refill method implementation
+void FrameGovernor::refill(unsigned long nowMillis) {
+  unsigned long elapsed = min(nowMillis - lastRefillMillis, 1000UL); // A full bucket takes 1 s
+  lastRefillMillis = nowMillis;
+  // budgetPerSecond ms per 1000 ms = budgetPerSecond us of SPI time per elapsed ms
+  creditMicros = min(creditMicros + (int32_t)elapsed * budgetPerSecond, budgetPerSecond * 1000);
+}
@@ -0,0 +1,59 @@
+// FrameGovernor.h
+#ifndef FrameGovernor_h // Include guard to prevent multiple inclusions
+#define FrameGovernor_h
+
+#include <Arduino.h>
+#include <atomic>
+
+// Decides when the rendering side draws a frame, independently of the inference rate.
+//
+// The inference side calls noteUpdate() after every published ControlFrame. The
+// rendering side polls beginFrame(): a frame is drawn only when something new was
+// published, at most once per frameInterval, and only while the SPI budget allows.
+// Updates published in between are coalesced (the TripleBuffer already keeps only the
+// latest one), so raising the control rate doesn't raise the display load.
+//
+// The budget is a token bucket of SPI time: it refills at budgetMillisPerSecond per
+// second up to one second's worth, and every frame is charged what it cost (endFrame()).
+// When it is empty, due frames are skipped until it has refilled, so a burst of expensive
+// frames (page switch, many changed fields) cannot starve the CPU or the SPI bus.
+class FrameGovernor {
+  public:
+    // frameIntervalMillis: minimum time between frames (0 = as often as there are updates).
+    // budgetMillisPerSecond: SPI time per second the display may use (1000 = unlimited).
+    FrameGovernor(unsigned long frameIntervalMillis, unsigned long budgetMillisPerSecond);
+
+    // Inference side (any core): a new frame state was published.
+    void noteUpdate() { updates.fetch_add(1, std::memory_order_release); }
+
+    // Rendering side: true if a frame should be drawn now. Consumes the pending updates;
+    // call endFrame() with the frame's cost afterwards.
+    bool beginFrame(unsigned long nowMillis);
+
+    // Rendering side: charges the SPI time of the frame just drawn to the budget.
+    void endFrame(unsigned long costMicros);
+
+    // Frames drawn, due frames skipped (deferred until the budget has refilled), and
+    // updates that were never drawn because a newer one replaced them first.
+    uint32_t framesRendered() const { return rendered; }
+    uint32_t framesSkipped() const { return skipped; }
+    uint32_t updatesCoalesced() const { return coalesced; }
+
+  private:
+    // Adds the SPI time earned since the last call, up to one second's budget.
+    void refill(unsigned long nowMillis);
+
+    std::atomic<uint32_t> updates; // Published updates (written by the inference side only)
+    uint32_t seenUpdates;          // Value of updates when the last frame was started
+
+    unsigned long frameInterval;
+    unsigned long nextFrameMillis; // Earliest time for the next frame
+
+    int32_t budgetPerSecond;       // Milliseconds of SPI time per second
+    int32_t creditMicros;          // SPI time left in the bucket (negative after an overdraw)
+    unsigned long lastRefillMillis;
+
+    uint32_t rendered, skipped, coalesced;
+};
+
+#endif // End of include guard
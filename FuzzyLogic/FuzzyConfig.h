@@ -0,0 +1,96 @@
+// FuzzyConfig.h
+#ifndef FuzzyConfig_h // Include guard to prevent multiple inclusions
+#define FuzzyConfig_h
+
+// Compile-time feature switches for the irrigation sketch.
+// The Arduino build only applies #defines written in the .ino to the .ino itself,
+// so options that the helper classes also need to see are collected here.
+// Each option can also be overridden from the build flags (e.g. -DFUZZY_DUAL_CORE=1).
+
+// Dual-core pipeline (ESP32 only): sensor acquisition and fuzzy inference run in a
+// FreeRTOS task pinned to core 0, display rendering and serial logging in a task
+// pinned to core 1. 0 keeps everything in the Arduino loop().
+#ifndef FUZZY_DUAL_CORE
+#define FUZZY_DUAL_CORE 0
+#endif
+
+#if FUZZY_DUAL_CORE && !defined(ESP32)
+#error "FUZZY_DUAL_CORE requires an ESP32 (dual-core FreeRTOS)"
+#endif
+
+// Coroutine task model: the sensor reads, fuzzy inference and display refresh run as
+// C++20 coroutines on the small CoExecutor polled from loop() (or from the acquisition
+// task in dual-core mode), and the DHT22 is read by edge capture instead of the
+// blocking DHT library. Needs a C++20 toolchain (e.g. arduino-esp32 3.x with -std=gnu++20).
+// 0 keeps the millis()-interval task functions.
+#ifndef FUZZY_COROUTINES
+#define FUZZY_COROUTINES 0
+#endif
+
+#if FUZZY_COROUTINES && !defined(__cpp_impl_coroutine)
+#error "FUZZY_COROUTINES requires C++20 coroutine support (-std=gnu++20)"
+#endif
+
+// Off-screen framebuffer: FuzzyDisplay draws into a 160x128 RGB565 buffer in RAM (40 KB)
+// and only pushes the changed regions to the panel, each as one address window plus one
+// continuous pixel burst. Assumes a landscape rotation (1 or 3). 0 draws straight to the TFT.
+#ifndef FUZZY_FRAMEBUFFER
+#define FUZZY_FRAMEBUFFER 0
+#endif
+
+// Asynchronous DMA flush (ESP32 + FUZZY_FRAMEBUFFER): after the panel is initialized, the
+// SPI bus is handed to the ESP-IDF spi_master driver and framebuffer flushes are queued as
+// DMA transactions. present() returns as soon as the changes are queued; the next flush
+// waits for the previous one to finish.
+#ifndef FUZZY_DMA_FLUSH
+#define FUZZY_DMA_FLUSH 0
+#endif
+
+#if FUZZY_DMA_FLUSH && (!defined(ESP32) || !FUZZY_FRAMEBUFFER)
+#error "FUZZY_DMA_FLUSH requires an ESP32 and FUZZY_FRAMEBUFFER"
+#endif
+
+// Binary telemetry: every rendered frame is sent over Serial as one compact COBS-framed
+// record (Telemetry.h) instead of the human-readable log line. Decode the stream with
+// host/telemetry_decode. 0 keeps the text log.
+#ifndef FUZZY_TELEMETRY
+#define FUZZY_TELEMETRY 0
+#endif
+
+// Flash data log (ESP32): a sample every flashLogInterval is appended to a circular log
+// in the "datalog" flash partition (partitions.csv), so history survives a reboot.
+// Extract it with host/flashlog_tool. 0 keeps readings on the serial output only.
+#ifndef FUZZY_FLASH_LOG
+#define FUZZY_FLASH_LOG 0
+#endif
+
+#if FUZZY_FLASH_LOG && !defined(ESP32)
+#error "FUZZY_FLASH_LOG requires an ESP32 (flash data partition)"
+#endif
+
+// Stored model (ESP32): the console's "save" writes the current sets and rules to the
+// "model" flash partition as a ModelBlob, and setup() runs the stored model in place if
+// the partition holds a valid one. 0 always starts with the built-in model.
+#ifndef FUZZY_MODEL_STORE
+#define FUZZY_MODEL_STORE 0
+#endif
+
+#if FUZZY_MODEL_STORE && !defined(ESP32)
+#error "FUZZY_MODEL_STORE requires an ESP32 (model flash partition)"
+#endif
+
+// Fast start: setup() no longer waits for the DHT22 to settle. The display and everything
+// else are initialized during the sensor's warm-up, the first readings are taken as soon
+// as each sensor allows, and the first inference runs as soon as all inputs are valid
+// instead of a logicInterval later. The time from boot to that first pump decision is
+// logged. 0 keeps the fixed delays (1 s in setup(), then one full interval per task).
+#ifndef FUZZY_FAST_START
+#define FUZZY_FAST_START 0
+#endif
+
+// Print per-update display traffic (SPI transactions, bytes, pixels) to Serial.
+#ifndef FUZZY_BENCHMARK
+#define FUZZY_BENCHMARK 0
+#endif
+
+#endif // End of include guard
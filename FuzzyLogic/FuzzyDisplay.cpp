@@ -5,156 +5,564 @@
 // Constructor implementation
 FuzzyDisplay::FuzzyDisplay(int8_t csPin, int8_t dcPin, int8_t rstPin) :
   tft(csPin, dcPin, rstPin), // Initialize the tft object
-  prevTemp(-999.9),          // Initialize previous values to unlikely states to force first draw
-  prevHumid(-999.9),
-  prevSoil(-999.9),
-  prevPump(-999.9) {
+#if FUZZY_DMA_FLUSH
+  dmaReady(false),
+#endif
+#if FUZZY_FRAMEBUFFER
+  gfx(frameBuffer),          // Draw off-screen, present() sends the changes
+#else
+  gfx(tft),                  // Draw straight to the panel
+#endif
+  flushStats({0, 0, 0}),
+  page(PAGE_READINGS),
+  history(HISTORY_COLUMN_MILLIS),
+  chartColumns(0),
+  hardwareScroll(false),
+  scrollTop(0),
+  scrollStart(0) {
+  for (uint8_t i = 0; i < SOURCE_COUNT; i++) {
+    values[i] = NAN; // No readings yet: numeric fields show "---"
+  }
+  for (uint8_t i = 0; i < MAX_PAGE_WIDGETS; i++) {
+    widgetStates[i] = {0, true}; // Nothing drawn yet
+  }
+  memset(ruleFiring, 0, sizeof(ruleFiring));
+  memset(memberships, MEMBERSHIP_UNKNOWN, sizeof(memberships));
+}
+
+// Readings page: title, sensor fields and pump output.
+// Fields are cleared up to their width, so the widest value must fit: "-40.0°C" (35 px),
+// "100.0 %" (38 px) and "100.0" at size 2 (60 px).
+const Widget FuzzyDisplay::READINGS_WIDGETS[] = {
+  labelWidget(10, 5, "Fuzzy Irrigation System", ST77XX_WHITE),
+  fillWidget(0, 20, FrameBuffer::FB_WIDTH, 1, ST77XX_WHITE),          // Separator line
+  labelWidget(10, 30, "Temp:", ST77XX_CYAN),
+  labelWidget(65, 30, "Humid:", ST77XX_CYAN),
+  labelWidget(123, 30, "Soil:", ST77XX_CYAN),
+  numberWidget(10, 40, 45, SOURCE_TEMPERATURE, FORMAT_TEMPERATURE),
+  numberWidget(65, 40, 40, SOURCE_HUMIDITY, FORMAT_PERCENT),
+  numberWidget(123, 40, 40, SOURCE_SOIL, FORMAT_PERCENT),             // Clipped at the screen edge
+  labelWidget(10, 60, "Pump Power Output:", ST77XX_GREEN),
+  numberWidget(55, 74, 70, SOURCE_PUMP, FORMAT_PUMP, 2),
+  barWidget(10, 100, 140, 15, SOURCE_PUMP, ST77XX_GREEN)
+};
+
+// History page: fixed label band (percent scale and legend), then the scrolling chart.
+const Widget FuzzyDisplay::HISTORY_WIDGETS[] = {
+  labelWidget(2, PLOT_TOP, "100", ST77XX_WHITE),
+  labelWidget(8, (PLOT_TOP + PLOT_BOTTOM) / 2 - 3, "50", ST77XX_WHITE),
+  labelWidget(14, PLOT_BOTTOM - 7, "0", ST77XX_WHITE),
+  labelWidget(2, 30, "S", ST77XX_CYAN),   // Soil moisture: cyan trace
+  labelWidget(2, 88, "P", ST77XX_GREEN),  // Pump power: green area
+  fillWidget(CHART_LABEL_WIDTH - 1, 0, 1, CHART_HEIGHT, HISTORY_GRID_COLOR),
+  chartWidget(CHART_LABEL_WIDTH, 0, CHART_WIDTH, CHART_HEIGHT)
+};
+
+// Rule page geometry: one 3x3 block (temperature rows x humidity columns) per soil set
+static const int16_t HEAT_CELL = 13;        // Cell size, with a 1 px gap to the next cell
+static const int16_t HEAT_PITCH = 14;
+static const int16_t HEAT_LEFT = 14;        // Left edge of the "dry" block
+static const int16_t HEAT_TOP = 38;
+static const int16_t HEAT_BLOCK_PITCH = 48; // 3 cells and a 7 px gap between blocks
+
+// Heatmap cell of one temperature x humidity x soil set combination (0 = low .. 2 = high)
+constexpr Widget ruleCell(uint8_t temp, uint8_t humid, uint8_t soil) {
+  return heatWidget(HEAT_LEFT + soil * HEAT_BLOCK_PITCH + humid * HEAT_PITCH, HEAT_TOP + temp * HEAT_PITCH,
+                    HEAT_CELL, (temp * RULE_GRID_LEVELS + humid) * RULE_GRID_LEVELS + soil);
 }
 
+// The 9 cells of one temperature row across all three soil blocks
+#define RULE_ROW(temp) \
+  ruleCell(temp, 0, 0), ruleCell(temp, 1, 0), ruleCell(temp, 2, 0), \
+  ruleCell(temp, 0, 1), ruleCell(temp, 1, 1), ruleCell(temp, 2, 1), \
+  ruleCell(temp, 0, 2), ruleCell(temp, 1, 2), ruleCell(temp, 2, 2)
+
+// Rule page: firing strength of every set combination of the latest inference
+const Widget FuzzyDisplay::RULES_WIDGETS[] = {
+  labelWidget(10, 5, "Rule Firing Strength", ST77XX_WHITE),
+  fillWidget(0, 20, FrameBuffer::FB_WIDTH, 1, ST77XX_WHITE),
+  labelWidget(HEAT_LEFT + 11, 26, "Dry", ST77XX_CYAN),                           // Soil set of each block
+  labelWidget(HEAT_LEFT + HEAT_BLOCK_PITCH + 5, 26, "Moist", ST77XX_CYAN),
+  labelWidget(HEAT_LEFT + 2 * HEAT_BLOCK_PITCH + 11, 26, "Wet", ST77XX_CYAN),
+  labelWidget(4, HEAT_TOP + 3, "L", ST77XX_CYAN),                                // Temperature set of each row
+  labelWidget(4, HEAT_TOP + HEAT_PITCH + 3, "M", ST77XX_CYAN),
+  labelWidget(4, HEAT_TOP + 2 * HEAT_PITCH + 3, "H", ST77XX_CYAN),
+  RULE_ROW(0),
+  RULE_ROW(1),
+  RULE_ROW(2),
+  labelWidget(4, 92, "Rows: temp L/M/H", ST77XX_WHITE),
+  labelWidget(4, 104, "Cols: humidity L/M/H", ST77XX_WHITE)
+};
+
+#undef RULE_ROW
+
+// Membership page geometry: one plot per input, with the degree of each set below it
+static const int16_t MEMBERSHIP_LEFT = 12;      // Left edge of the plots (input name left of it)
+static const int16_t MEMBERSHIP_TOP = 24;
+static const int16_t MEMBERSHIP_PITCH = 34;     // Plot, 2 px gap, degree row, 2 px gap
+static const int16_t MEMBERSHIP_SET_PITCH = 50; // Distance between the degree fields of a row
+
+// Plot and degree row of one input (0 = temperature, 1 = humidity, 2 = soil moisture)
+#define MEMBERSHIP_ROW(input, source, name) \
+  labelWidget(2, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 7, name, ST77XX_CYAN), \
+  membershipWidget(MEMBERSHIP_LEFT, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH, \
+                   MembershipPlot::WIDTH, MembershipPlot::HEIGHT, source, input), \
+  labelWidget(MEMBERSHIP_LEFT, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, "L", MembershipPlot::LOW_COLOR), \
+  degreeWidget(MEMBERSHIP_LEFT + 8, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, \
+               input * RULE_GRID_LEVELS + 0, MembershipPlot::LOW_COLOR), \
+  labelWidget(MEMBERSHIP_LEFT + MEMBERSHIP_SET_PITCH, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, \
+              "M", MembershipPlot::MEDIUM_COLOR), \
+  degreeWidget(MEMBERSHIP_LEFT + MEMBERSHIP_SET_PITCH + 8, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, \
+               input * RULE_GRID_LEVELS + 1, MembershipPlot::MEDIUM_COLOR), \
+  labelWidget(MEMBERSHIP_LEFT + 2 * MEMBERSHIP_SET_PITCH, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, \
+              "H", MembershipPlot::HIGH_COLOR), \
+  degreeWidget(MEMBERSHIP_LEFT + 2 * MEMBERSHIP_SET_PITCH + 8, MEMBERSHIP_TOP + input * MEMBERSHIP_PITCH + 24, \
+               input * RULE_GRID_LEVELS + 2, MembershipPlot::HIGH_COLOR)
+
+// Membership page: the sets of every input, a marker at the current input value and the
+// membership degrees the latest inference computed. The curves are drawn once per page
+// switch; updates only move the markers and rewrite the degree fields that changed.
+const Widget FuzzyDisplay::MEMBERSHIP_WIDGETS[] = {
+  labelWidget(10, 5, "Membership Functions", ST77XX_WHITE),
+  fillWidget(0, 20, FrameBuffer::FB_WIDTH, 1, ST77XX_WHITE),
+  MEMBERSHIP_ROW(0, SOURCE_TEMPERATURE, "T"),
+  MEMBERSHIP_ROW(1, SOURCE_HUMIDITY, "H"),
+  MEMBERSHIP_ROW(2, SOURCE_SOIL, "S")
+};
+
+#undef MEMBERSHIP_ROW
+
+const FuzzyDisplay::PageLayout FuzzyDisplay::PAGES[PAGE_COUNT] = {
+  {READINGS_WIDGETS, sizeof(READINGS_WIDGETS) / sizeof(READINGS_WIDGETS[0])},
+  {HISTORY_WIDGETS, sizeof(HISTORY_WIDGETS) / sizeof(HISTORY_WIDGETS[0])},
+  {RULES_WIDGETS, sizeof(RULES_WIDGETS) / sizeof(RULES_WIDGETS[0])},
+  {MEMBERSHIP_WIDGETS, sizeof(MEMBERSHIP_WIDGETS) / sizeof(MEMBERSHIP_WIDGETS[0])}
+};
+
 // begin method implementation
 void FuzzyDisplay::begin(uint8_t rotation) {
+  atlas.begin(); // Rasterize the numeric glyphs once
   tft.initR(INITR_GREENTAB); // Initialize TFT with Green Tab configuration
   tft.setRotation(rotation); // Set the display rotation
   tft.fillScreen(ST77XX_BLACK); // Clear the screen to black
+#if !FUZZY_FRAMEBUFFER
+  // Hardware scrolling moves frame-memory lines, which run along x in rotation 3 (MX|MV).
+  // Other rotations (and the framebuffer) use the sweep chart instead.
+  hardwareScroll = (rotation == 3);
+  scrollTop = tft.xOffset() + CHART_LABEL_WIDTH;
+  scrollStart = scrollTop;
+#endif
+#if FUZZY_DMA_FLUSH
+  dmaReady = dmaFlusher.begin(tft); // From here on the panel is only written by DMA
+#endif
+}
+
+#if FUZZY_DMA_FLUSH
+// setFlushCallback method implementation
+void FuzzyDisplay::setFlushCallback(DmaFlusher::CompletionCallback callback, void* context) {
+  dmaFlusher.setCompletionCallback(callback, context);
 }
+#endif
 
 // drawLayout method implementation
 void FuzzyDisplay::drawLayout() {
-  tft.setTextSize(1); // Set default text size
-  
-  // Print the main title
-  tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK); // White text on black background
-  tft.setCursor(10, 5);
-  tft.println("Fuzzy Irrigation System");
-  
-  // Draw a horizontal line separator
-  tft.drawFastHLine(0, 20, tft.width(), ST77XX_WHITE); // Line across the screen width
-  
-  // Print sensor labels
-  tft.setTextColor(ST77XX_CYAN, ST77XX_BLACK); // Cyan text for labels
-  tft.setCursor(10, 30);
-  tft.print("Temp:");
-  tft.setCursor(65, 30);
-  tft.print("Humid:");
-  tft.setCursor(123, 30);
-  tft.print("Soil:");
-
-  // Print pump power label
-  tft.setTextColor(ST77XX_GREEN, ST77XX_BLACK); // Green text for pump label
-  tft.setCursor(10, 60);
-  tft.print("Pump Power Output:");
+  showPage(page);
 }
 
 // updateValues method implementation
 void FuzzyDisplay::updateValues(float temp, float humid, float soil, float pump) {
-  bool pumpChanged = false; // Flag to track if pump value or bar needs redraw
-
-  // Update Temperature if changed or if it's the first time (prevTemp is NAN or initial value)
-  // A small threshold (0.05) is used to avoid flickering from minor fluctuations.
-  if (isnan(temp) || isnan(prevTemp) || abs(temp - prevTemp) > 0.05) {
-    tft.fillRect(10, 40, 45, 11, ST77XX_BLACK); // Clear previous temperature value area
-    tft.setTextSize(1);
-    tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
-    tft.setCursor(10, 40);
-    if (isnan(temp)) { // If temperature is Not a Number, display "---"
-      tft.print("---");
-    } else {
-      tft.print(temp, 1); // Print temperature with 1 decimal place
-      // Custom logic to position the degree symbol 'C' correctly based on number of digits
-      int t = 36; // Base X position for degree symbol
-      if (temp < 0) { // Adjust for negative sign
-        t += 5; 
-        if (abs(temp) < 10 && temp != 0) t += 5; // Adjust for single digit negative numbers
-      } 
-      else if (abs(temp) < 10 && temp != 0) { // Adjust for single digit positive numbers
-        t -=5; 
+  values[SOURCE_TEMPERATURE] = temp;
+  values[SOURCE_HUMIDITY] = humid;
+  values[SOURCE_SOIL] = soil;
+  values[SOURCE_PUMP] = pump;
+  history.add(soil, pump, millis()); // Fed on every page; the chart widget keys on total()
+  render();
+}
+
+// setRuleFiring method implementation
+void FuzzyDisplay::setRuleFiring(const uint8_t* strengths) {
+  memcpy(ruleFiring, strengths, sizeof(ruleFiring));
+}
+
+// setMemberships method implementation
+void FuzzyDisplay::setMemberships(const uint8_t* degrees) {
+  memcpy(memberships, degrees, sizeof(memberships));
+}
+
+// setMembershipSet method implementation
+void FuzzyDisplay::setMembershipSet(uint8_t input, uint8_t set, float a, float b, float c, float d) {
+  if (input >= MEMBERSHIP_INPUTS) {
+    return;
+  }
+  membershipPlots[input].setSet(set, a, b, c, d); // Rebuilds the plot's cached background
+
+  // A plot on screen is redrawn from the new background with the next render()
+  const PageLayout& layout = PAGES[page];
+  for (uint8_t i = 0; i < layout.count; i++) {
+    if (layout.widgets[i].type == WIDGET_MEMBERSHIP && layout.widgets[i].index == input) {
+      widgetStates[i].dirty = true;
+    }
+  }
+}
+
+// showPage method implementation
+void FuzzyDisplay::showPage(Page newPage) {
+  if (hardwareScroll) {
+    setScrollStart(scrollTop); // Back to an unscrolled screen
+  }
+  page = newPage;
+  gfx.fillScreen(ST77XX_BLACK);
+
+  // Everything was cleared: every widget of the new page is drawn completely
+  for (uint8_t i = 0; i < MAX_PAGE_WIDGETS; i++) {
+    widgetStates[i].dirty = true;
+  }
+  render();
+}
+
+// render method implementation
+void FuzzyDisplay::render() {
+  static_assert(sizeof(READINGS_WIDGETS) / sizeof(Widget) <= MAX_PAGE_WIDGETS,
+                "Readings page has more widgets than MAX_PAGE_WIDGETS");
+  static_assert(sizeof(HISTORY_WIDGETS) / sizeof(Widget) <= MAX_PAGE_WIDGETS,
+                "History page has more widgets than MAX_PAGE_WIDGETS");
+  static_assert(sizeof(RULES_WIDGETS) / sizeof(Widget) <= MAX_PAGE_WIDGETS,
+                "Rule page has more widgets than MAX_PAGE_WIDGETS");
+  static_assert(sizeof(MEMBERSHIP_WIDGETS) / sizeof(Widget) <= MAX_PAGE_WIDGETS,
+                "Membership page has more widgets than MAX_PAGE_WIDGETS");
+
+  const PageLayout& layout = PAGES[page];
+  for (uint8_t i = 0; i < layout.count; i++) {
+    const Widget& widget = layout.widgets[i];
+    WidgetState& state = widgetStates[i];
+    // A widget is redrawn exactly when its on-screen representation changes. Slow drifts
+    // are caught once they reach the next displayed step; noise inside one step never
+    // causes a redraw.
+    int32_t key = widgetKey(widget);
+    if (state.dirty || key != state.key) {
+      drawWidget(widget, state, key);
+      state.key = key; // Store what is now on screen for the next comparison
+      state.dirty = false;
+    }
+  }
+  present();
+}
+
+// widgetKey method implementation
+int32_t FuzzyDisplay::widgetKey(const Widget& widget) const {
+  float value = values[widget.source];
+  switch (widget.type) {
+    case WIDGET_NUMBER:
+      if (widget.source == SOURCE_MEMBERSHIP) {
+        uint8_t degree = memberships[widget.index]; // Already in the hundredths shown
+        return degree == MEMBERSHIP_UNKNOWN ? FIELD_NAN : degree;
+      }
+      if (isnan(value)) {
+        return FIELD_NAN;
       }
-      else if (temp == 0) { // Adjust for zero
-        t-=5;
+      if (widget.format == FORMAT_PUMP) {
+        // Key = displayed tenths, whole-number format flag and color band.
+        // Show 0 decimal places if it's a whole number, 1 otherwise.
+        // Constrain pump value to 0-100 range for display.
+        uint8_t band = value < 20 ? 0 : (value < 50 ? 1 : 2);
+        bool whole = value == (int)value && value >= 0 && value <= 100;
+        return toTenths(constrain(value, 0.0f, 100.0f)) * 8 + (whole ? 4 : 0) + band;
       }
+      return toTenths(value); // Value in tenths, as the one-decimal text shows it
 
-      // Draw a small degree symbol (°) using pixels
-      tft.drawPixel(t, 40, ST77XX_WHITE);
-      tft.drawPixel(t-1, 40, ST77XX_WHITE);
-      tft.drawPixel(t, 41, ST77XX_WHITE);
-      tft.drawPixel(t-1, 41, ST77XX_WHITE);
-      tft.setCursor(t + 2, 40); // Position cursor for 'C'
-      tft.print("C");
+    case WIDGET_BAR:
+      if (isnan(value)) {
+        return 0;
+      }
+      // Map constrained value (0-100) to the bar's inner width (inside the 1 px border)
+      return map(constrain(value, 0, 100), 0, 100, 0, widget.w - 2);
+
+    case WIDGET_CHART:
+      return (int32_t)history.total(); // Changes once per stored sample
+
+    case WIDGET_HEAT: {
+      // Quantized to the color steps; any firing at all gets at least the first step
+      uint8_t strength = ruleFiring[widget.index];
+      return strength == 0 ? 0 : 1 + (int32_t)(strength - 1) * (HEAT_LEVELS - 1) / 255;
     }
-    prevTemp = temp; // Store current temperature as previous for next comparison
+
+    case WIDGET_MEMBERSHIP:
+      return membershipPlots[widget.index].column(value); // Marker column, -1 = no marker
+
+    default:
+      return 0; // Static widgets only draw when dirty
   }
+}
 
-  // Update Humidity if changed or if it's the first time
-  if (isnan(humid) || isnan(prevHumid) || abs(humid - prevHumid) > 0.05) {
-    tft.fillRect(65, 40, 40, 11, ST77XX_BLACK); // Clear previous humidity value area
-    tft.setTextSize(1);
-    tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
-    tft.setCursor(65, 40);
-     if (isnan(humid)) { // If humidity is Not a Number, display "---"
-      tft.print("---");
-    } else {
-      tft.print(humid, 1); // Print humidity with 1 decimal place
-      int valEndX = tft.getCursorX(); // Get X position after printing the number
-      tft.setCursor(valEndX + 2, 40); // Position cursor for '%' symbol
-      tft.print("%");
+// drawWidget method implementation
+void FuzzyDisplay::drawWidget(const Widget& widget, const WidgetState& state, int32_t key) {
+  switch (widget.type) {
+    case WIDGET_LABEL:
+      gfx.setTextSize(widget.textSize);
+      gfx.setTextColor(widget.color, ST77XX_BLACK);
+      gfx.setCursor(widget.x, widget.y);
+      gfx.print(widget.text);
+      break;
+
+    case WIDGET_FILL:
+      gfx.fillRect(widget.x, widget.y, widget.w, widget.h, widget.color);
+      break;
+
+    case WIDGET_NUMBER: {
+      char text[12]; // Field text composed for the digit atlas
+      uint16_t color = formatNumber(widget.format, key, widget.color, text);
+      drawField(widget.x, widget.y, widget.w, text, widget.textSize, color);
+      break;
+    }
+
+    case WIDGET_BAR:
+      if (state.dirty) {
+        // Border drawn once; bar updates stay inside it
+        gfx.fillRect(widget.x, widget.y, widget.w, widget.h, ST77XX_BLACK);
+        gfx.drawRect(widget.x, widget.y, widget.w, widget.h, ST77XX_WHITE);
+        drawBarDelta(widget, 0, key); // Inside of the border is empty
+      } else {
+        drawBarDelta(widget, state.key, key);
+      }
+      break;
+
+    case WIDGET_CHART:
+      if (state.dirty) {
+        drawChart(widget);
+      } else {
+        // Append the samples stored since the last pass (normally one)
+        uint32_t added = min((uint32_t)(key - state.key), (uint32_t)history.count());
+        for (uint8_t i = history.count() - added; i < history.count(); i++) {
+          appendHistoryColumn(widget, history.at(i));
+        }
+      }
+      break;
+
+    case WIDGET_HEAT:
+      gfx.fillRect(widget.x, widget.y, widget.w, widget.h, heatColor(key)); // One window per changed cell
+      break;
+
+    case WIDGET_MEMBERSHIP:
+      drawMembership(widget, state, key);
+      break;
+  }
+}
+
+// formatNumber method implementation
+uint16_t FuzzyDisplay::formatNumber(WidgetFormat format, int32_t key, uint16_t color, char* text) {
+  if (key == FIELD_NAN) { // Value is Not a Number: display "---" ("--" for the larger pump text)
+    strcpy(text, format == FORMAT_PUMP ? "--" : "---");
+    return color;
+  }
+
+  char* end;
+  switch (format) {
+    case FORMAT_TEMPERATURE:
+      // Temperature with 1 decimal place, then the degree mark and 'C' right after the digits
+      end = formatTenths(key, text);
+      *end++ = DigitAtlas::DEGREE;
+      *end++ = 'C';
+      *end = '\0';
+      return color;
+
+    case FORMAT_DEGREE:
+      // Hundredths as "0.65" / "1.00"
+      text[0] = '0' + key / 100;
+      text[1] = '.';
+      text[2] = '0' + key / 10 % 10;
+      text[3] = '0' + key % 10;
+      text[4] = '\0';
+      return color;
+
+    case FORMAT_PUMP: {
+      int32_t tenths = key / 8; // Unpack the key built by widgetKey()
+      if (key & 4) {
+        formatInteger(tenths / 10, text);
+      } else {
+        formatTenths(tenths, text);
+      }
+      // Text color based on pump power level
+      static const uint16_t bandColors[3] = {ST77XX_BLUE, ST77XX_YELLOW, ST77XX_RED};
+      return bandColors[key & 3];
     }
-    prevHumid = humid; // Store current humidity as previous
+
+    default:
+      end = formatTenths(key, text); // Percentage with 1 decimal place
+      *end++ = DigitAtlas::THIN_SPACE; // 2 px gap before the '%' symbol
+      *end++ = '%';
+      *end = '\0';
+      return color;
+  }
+}
+
+// drawChart method implementation
+void FuzzyDisplay::drawChart(const Widget& chart) {
+  if (hardwareScroll) {
+    // Scroll area = the chart columns; the label band (and the hidden offset line) stay fixed
+    scrollTop = tft.xOffset() + chart.x;
+    uint16_t scrollLines = chart.w;
+    uint16_t bottomLines = ST7735_MEMORY_LINES - scrollTop - scrollLines;
+    uint8_t definition[6] = {
+      (uint8_t)(scrollTop >> 8), (uint8_t)scrollTop,
+      (uint8_t)(scrollLines >> 8), (uint8_t)scrollLines,
+      (uint8_t)(bottomLines >> 8), (uint8_t)bottomLines
+    };
+    tft.sendCommand(ST7735_VSCRDEF, definition, 6);
+    scrollStart = scrollTop;
+    setScrollStart(scrollStart);
   }
 
-  // Update Soil Moisture if changed or if it's the first time
-  if (isnan(soil) || isnan(prevSoil) || abs(soil - prevSoil) > 0.05) {
-    tft.fillRect(123, 40, 40, 11, ST77XX_BLACK); // Clear previous soil moisture value area
-    tft.setTextSize(1);
-    tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
-    tft.setCursor(123, 40);
-    if (isnan(soil)) { // If soil moisture is Not a Number, display "---"
-      tft.print("---");
+  chartColumns = 0;
+  for (uint8_t i = 0; i < history.count(); i++) {
+    appendHistoryColumn(chart, history.at(i));
+  }
+}
+
+// appendHistoryColumn method implementation
+void FuzzyDisplay::appendHistoryColumn(const Widget& chart, HistorySample sample) {
+  static uint16_t column[CHART_HEIGHT]; // The chart widget is CHART_HEIGHT tall
+  renderHistoryColumn(sample, column);
+
+  if (hardwareScroll) {
+    uint16_t line;
+    if (chartColumns < (uint32_t)chart.w) {
+      line = scrollTop + chartColumns; // Chart not full yet: fill from the left, no scrolling
     } else {
-      tft.print(soil, 1); // Print soil moisture with 1 decimal place
-      int valEndX = tft.getCursorX(); // Get X position after printing the number
-      tft.setCursor(valEndX + 2, 40); // Position cursor for '%' symbol
-      tft.print("%");
+      // Overwrite the oldest column (shown at the left) and make it the rightmost one
+      line = scrollStart;
+      scrollStart = (scrollStart + 1 < scrollTop + chart.w) ? scrollStart + 1 : scrollTop;
     }
-    prevSoil = soil; // Store current soil moisture as previous
-  }
-
-  // Update Pump Power text if changed or if it's the first time. Using a larger threshold for pump.
-  if (isnan(pump) || isnan(prevPump) || abs(pump - prevPump) > 0.5) { 
-    pumpChanged = true; // Indicate that the pump value (and thus bar) needs updating
-    tft.fillRect(55, 74, 70, 16, ST77XX_BLACK); // Clear previous pump power value area
-    tft.setTextSize(2); // Use larger text for pump power
-    if (isnan(pump)) { // If pump power is Not a Number, display "--" (due to larger text size)
-        tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
-        tft.setCursor(55,74);
-        tft.print("--"); 
-    } else {
-        // Change text color based on pump power level
-        if (pump < 20) {
-        tft.setTextColor(ST77XX_BLUE, ST77XX_BLACK);
-        } else if (pump < 50) {
-        tft.setTextColor(ST77XX_YELLOW, ST77XX_BLACK);
-        } else {
-        tft.setTextColor(ST77XX_RED, ST77XX_BLACK);
-        }
-        tft.setCursor(55, 74);
-        // Print pump power. Show 0 decimal places if it's a whole number, 1 otherwise.
-        // Constrain pump value to 0-100 range for display.
-        tft.print(constrain(pump, 0, 100.0), (pump == (int)pump && pump >=0 && pump <=100) ? 0 : 1 ); 
+    blit(line - tft.xOffset(), chart.y, column, 1, CHART_HEIGHT); // Unscrolled x of that memory line
+    if (chartColumns >= (uint32_t)chart.w) {
+      setScrollStart(scrollStart);
     }
-    prevPump = pump; // Store current pump power as previous
-  }
-  
-  // Update Pump Power bar graph if pump value changed or if it's the initial draw
-  if (pumpChanged || prevPump == -999.9) { // -999.9 is the initial prevPump value
-    tft.fillRect(10, 100, 140, 15, ST77XX_BLACK); // Clear previous bar area
-    
-    int barWidth = 0;
-    if(!isnan(pump)){ // Calculate bar width only if pump value is valid
-        // Map constrained pump value (0-100) to bar width (0-140 pixels)
-        barWidth = map(constrain(pump, 0, 100), 0, 100, 0, 140);
+  } else {
+    // Sweep: columns wrap around like an oscilloscope trace, with a marker column ahead
+    // of the newest sample. Costs two columns per sample.
+    int16_t x = chart.x + chartColumns % chart.w;
+    blit(x, chart.y, column, 1, CHART_HEIGHT);
+    if (chartColumns + 1 >= (uint32_t)chart.w) {
+      int16_t next = chart.x + (chartColumns + 1) % chart.w;
+      for (int16_t y = 0; y < CHART_HEIGHT; y++) column[y] = HISTORY_GRID_COLOR;
+      blit(next, chart.y, column, 1, CHART_HEIGHT);
     }
-    
-    tft.fillRect(10, 100, barWidth, 15, ST77XX_GREEN); // Draw the new bar
-    tft.drawRect(10, 100, 140, 15, ST77XX_WHITE);     // Draw a border around the bar area
   }
+  chartColumns++;
+}
+
+// renderHistoryColumn method implementation
+void FuzzyDisplay::renderHistoryColumn(HistorySample sample, uint16_t* column) {
+  const int16_t span = PLOT_BOTTOM - PLOT_TOP;
+  for (int16_t y = 0; y < CHART_HEIGHT; y++) {
+    column[y] = ST77XX_BLACK;
+  }
+  // Grid dots at 0 %, 50 % and 100 %
+  column[PLOT_TOP] = column[PLOT_TOP + span / 2] = column[PLOT_BOTTOM] = HISTORY_GRID_COLOR;
+
+  if (sample.pump != HistoryBuffer::NO_DATA) { // Pump power as a filled area from the bottom
+    for (int16_t y = PLOT_BOTTOM - (int16_t)sample.pump * span / 100; y <= PLOT_BOTTOM; y++) {
+      column[y] = HISTORY_PUMP_COLOR;
+    }
+  }
+  if (sample.soil != HistoryBuffer::NO_DATA) { // Soil moisture as a 2 px trace on top
+    int16_t y = PLOT_BOTTOM - (int16_t)sample.soil * span / 100;
+    column[y] = ST77XX_CYAN;
+    column[y > PLOT_TOP ? y - 1 : y + 1] = ST77XX_CYAN;
+  }
+}
+
+// heatColor method implementation
+// Dark gray for rules that don't fire, then dark red through red to yellow.
+uint16_t FuzzyDisplay::heatColor(int32_t level) {
+  if (level <= 0) {
+    return 0x2104;
+  }
+  uint16_t red = min(level * 4, (int32_t)31);                 // 5 bits
+  uint16_t green = level > 7 ? (uint16_t)((level - 7) * 7) : 0; // 6 bits, up to 56
+  return (red << 11) | (green << 5);
+}
+
+// drawMembership method implementation
+void FuzzyDisplay::drawMembership(const Widget& plot, const WidgetState& state, int16_t marker) {
+  const MembershipPlot& membership = membershipPlots[plot.index];
+  static uint16_t column[MembershipPlot::HEIGHT]; // The plot widgets are MembershipPlot::HEIGHT tall
+  if (state.dirty) {
+    // Whole plot from the cached background, in blocks of 16 columns
+    static uint16_t block[16 * MembershipPlot::HEIGHT];
+    for (int16_t x0 = 0; x0 < plot.w; x0 += 16) {
+      int16_t w = min((int16_t)16, (int16_t)(plot.w - x0));
+      for (int16_t dx = 0; dx < w; dx++) {
+        membership.renderColumn(x0 + dx, x0 + dx == marker, column);
+        for (int16_t y = 0; y < plot.h; y++) {
+          block[y * w + dx] = column[y];
+        }
+      }
+      blit(plot.x + x0, plot.y, block, w, plot.h);
+    }
+    return;
+  }
+
+  // Marker moved: restore the column it leaves, then draw it on the new one
+  if (state.key >= 0) {
+    membership.renderColumn(state.key, false, column);
+    blit(plot.x + state.key, plot.y, column, 1, plot.h);
+  }
+  if (marker >= 0) {
+    membership.renderColumn(marker, true, column);
+    blit(plot.x + marker, plot.y, column, 1, plot.h);
+  }
+}
+
+// setScrollStart method implementation
+void FuzzyDisplay::setScrollStart(uint16_t line) {
+  uint8_t start[2] = {(uint8_t)(line >> 8), (uint8_t)line};
+  tft.sendCommand(ST7735_VSCSAD, start, 2);
+}
+
+// drawBarDelta method implementation
+// Grows the bar in its color or shrinks it in black by the difference to the previous width,
+// so a typical update touches a strip of a few pixels instead of the whole bar area.
+void FuzzyDisplay::drawBarDelta(const Widget& bar, int16_t oldWidth, int16_t newWidth) {
+  const int16_t innerX = bar.x + 1;     // Inside the 1 px border
+  const int16_t innerY = bar.y + 1;
+  const int16_t innerHeight = bar.h - 2;
+  if (newWidth > oldWidth) {
+    gfx.fillRect(innerX + oldWidth, innerY, newWidth - oldWidth, innerHeight, bar.color);
+  } else if (newWidth < oldWidth) {
+    gfx.fillRect(innerX + newWidth, innerY, oldWidth - newWidth, innerHeight, ST77XX_BLACK);
+  }
+}
+
+// drawField method implementation
+void FuzzyDisplay::drawField(int16_t x, int16_t y, int16_t width, const char* text, uint8_t size, uint16_t color) {
+  static uint16_t block[70 * 16]; // Largest field: the size-2 pump value
+  width = min(width, (int16_t)(gfx.width() - x));
+  int16_t height = 8 * size;
+  if (width <= 0 || (int32_t)width * height > (int32_t)(sizeof(block) / sizeof(block[0]))) {
+    return;
+  }
+  atlas.render(text, size, color, ST77XX_BLACK, block, width);
+  blit(x, y, block, width, height);
+}
+
+// blit method implementation
+void FuzzyDisplay::blit(int16_t x, int16_t y, const uint16_t* block, int16_t w, int16_t h) {
+#if FUZZY_FRAMEBUFFER
+  frameBuffer.drawBlock(x, y, block, w, h);
+#else
+  tft.drawRGBBitmap(x, y, (uint16_t*)block, w, h); // Adafruit_SPITFT: one address window + pixel burst
+#endif
+}
+
+// present method implementation
+void FuzzyDisplay::present() {
+#if FUZZY_DMA_FLUSH
+  if (dmaReady) {
+    flushStats = dmaFlusher.flushAsync(frameBuffer); // Returns once queued; waits only for the previous frame
+    return;
+  }
+#endif
+#if FUZZY_FRAMEBUFFER
+  flushStats = frameBuffer.flush(tft);
+#endif
 }
\ No newline at end of file
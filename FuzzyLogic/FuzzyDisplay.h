@@ -3,6 +3,16 @@
 #define FuzzyDisplay_h
 
 #include <Adafruit_ST7735.h> // Include the Adafruit ST7735 library for TFT display control
+#include "FuzzyConfig.h"
+#include "FrameBuffer.h"
+#include "St7735Panel.h"
+#include "DmaFlusher.h"
+#include "DigitAtlas.h"
+#include "HistoryBuffer.h"
+#include "DisplayWidget.h"
+#include "ControlFrame.h"
+#include "MembershipPlot.h"
+#include "FixedFormat.h"
 
 // Defines a class to manage the TFT display for the fuzzy irrigation system.
 class FuzzyDisplay {
@@ -17,8 +27,8 @@ class FuzzyDisplay {
     // rotation: Sets the screen rotation (0-3). Default is 3.
     void begin(uint8_t rotation = 3); 
 
-    // Draws the static layout of the user interface on the TFT screen.
-    // This includes titles, labels, and lines that don't change.
+    // Clears the screen and draws the current page completely (labels, lines and
+    // the latest values).
     void drawLayout();
 
     // Updates the dynamic values (sensor readings and pump power) on the TFT screen.
@@ -26,17 +36,159 @@ class FuzzyDisplay {
     // humid: Current humidity value.
     // soil: Current soil moisture value.
     // pump: Current calculated pump power value.
+    // Also feeds the soil/pump history, whichever page is shown.
     void updateValues(float temp, float humid, float soil, float pump);
 
+    // Stores the rule grid firing strengths of the latest inference (ControlFrame::ruleFiring)
+    // for the rule page. Drawn by the next updateValues().
+    void setRuleFiring(const uint8_t* strengths);
+
+    // Stores the membership degrees of the latest inference (ControlFrame::memberships)
+    // for the membership page. Drawn by the next updateValues().
+    void setMemberships(const uint8_t* degrees);
+
+    // Gives the trapezoid (a, b, c, d) of one input set to the membership page.
+    // input: 0 = temperature, 1 = humidity, 2 = soil moisture; set: 0 = low .. 2 = high.
+    // Call for every set before the page is first shown (setup()); calling it again later
+    // (tuning) redraws the plot if it is on screen.
+    void setMembershipSet(uint8_t input, uint8_t set, float a, float b, float c, float d);
+
+    // Screens the display can show.
+    enum Page {
+      PAGE_READINGS, // Current readings and pump power
+      PAGE_HISTORY,  // Scrolling soil moisture / pump power trend chart
+      PAGE_RULES,    // Heatmap of the rule grid firing strengths
+      PAGE_MEMBERSHIP, // Membership functions of the inputs with the current values
+      PAGE_COUNT
+    };
+
+    // Switches to page and draws it completely with the latest values.
+    void showPage(Page page);
+
+    // Page currently shown.
+    Page currentPage() const { return page; }
+
+    // Averaging period of one history chart column.
+    static const unsigned long HISTORY_COLUMN_MILLIS = 60000UL;
+
+    // Quantized numeric field state for "---" (value is NAN).
+    static const int32_t FIELD_NAN = TENTHS_NAN;
+
+    // Most widgets a page table may contain.
+    static const uint8_t MAX_PAGE_WIDGETS = 40;
+
+    // Display traffic of the last drawLayout()/updateValues() call (framebuffer mode only).
+    const FlushStats& lastFlushStats() const { return flushStats; }
+
+#if FUZZY_DMA_FLUSH
+    // Sets a function called from the SPI interrupt whenever an asynchronous flush has
+    // been fully sent to the panel.
+    void setFlushCallback(DmaFlusher::CompletionCallback callback, void* context);
+
+    // True while the last update is still being transferred by DMA.
+    bool isFlushing() const { return dmaReady && dmaFlusher.isBusy(); }
+#endif
+
   private:
-    Adafruit_ST7735 tft; // An instance of the Adafruit_ST7735 class to interact with the display.
-
-    // Member variables to store the previous sensor and pump values.
-    // These are used to optimize display updates by only redrawing values that have changed.
-    float prevTemp;    // Stores the previously displayed temperature.
-    float prevHumid;   // Stores the previously displayed humidity.
-    float prevSoil;    // Stores the previously displayed soil moisture.
-    float prevPump;    // Stores the previously displayed pump power.
+    // Pushes everything drawn since the last call to the panel (no-op when drawing directly).
+    void present();
+
+    // Widget table of a page.
+    struct PageLayout {
+      const Widget* widgets;
+      uint8_t count;
+    };
+
+    // Page tables (FuzzyDisplay.cpp), indexed by Page
+    static const Widget READINGS_WIDGETS[];
+    static const Widget HISTORY_WIDGETS[];
+    static const Widget RULES_WIDGETS[];
+    static const Widget MEMBERSHIP_WIDGETS[];
+    static const PageLayout PAGES[PAGE_COUNT];
+
+    // Draws every widget of the current page that is dirty or whose key changed,
+    // then presents the result. The one drawing path for all pages.
+    void render();
+
+    // Quantized content of a widget for the current values (what it would show).
+    int32_t widgetKey(const Widget& widget) const;
+
+    // Draws a widget whose key changed from state.key to key (completely if state.dirty).
+    void drawWidget(const Widget& widget, const WidgetState& state, int32_t key);
+
+    // Writes the text of a numeric field key and returns its color (color, unless the
+    // format picks its own).
+    static uint16_t formatNumber(WidgetFormat format, int32_t key, uint16_t color, char* text);
+
+    // Moves the end of a bar from oldWidth to newWidth (inner pixels): grows it in the
+    // bar color or shrinks it in black, touching only the strip in between.
+    void drawBarDelta(const Widget& bar, int16_t oldWidth, int16_t newWidth);
+
+    // Draws a numeric field from the digit atlas as one block: text in color on black,
+    // padded with black up to width (clearing the previous value), clipped to the screen.
+    void drawField(int16_t x, int16_t y, int16_t width, const char* text, uint8_t size, uint16_t color);
+
+    // Sends a w x h RGB565 block to (x, y) as a single rectangular transfer.
+    void blit(int16_t x, int16_t y, const uint16_t* block, int16_t w, int16_t h);
+
+    // History chart geometry: fixed label band on the left, one column per sample
+    static const int16_t CHART_LABEL_WIDTH = 24;
+    static const int16_t CHART_WIDTH = HistoryBuffer::CAPACITY; // 136 columns
+    static const int16_t CHART_HEIGHT = 128;
+    static const int16_t PLOT_TOP = 4;       // y of 100%
+    static const int16_t PLOT_BOTTOM = 123;  // y of 0%
+    static const uint8_t ST7735_VSCRDEF = 0x33; // Vertical scroll definition
+    static const uint8_t ST7735_VSCSAD = 0x37;  // Vertical scroll start address
+    static const int16_t ST7735_MEMORY_LINES = 162;
+    static const uint16_t HISTORY_GRID_COLOR = 0x4208; // Dark gray
+    static const uint16_t HISTORY_PUMP_COLOR = 0x0320; // Dim green
+
+    // Draws the chart widget from scratch: sets up hardware scrolling and draws every
+    // stored sample.
+    void drawChart(const Widget& chart);
+
+    // Adds one sample to the right end of the chart. With hardware scrolling the panel
+    // shifts the chart by one column, so only the new column is sent.
+    void appendHistoryColumn(const Widget& chart, HistorySample sample);
+
+    // Renders the 1 x CHART_HEIGHT pixel column for a sample.
+    void renderHistoryColumn(HistorySample sample, uint16_t* column);
+
+    // Sets the ST7735 scroll start line (hardware scroll mode only).
+    void setScrollStart(uint16_t line);
+
+    // Heatmap color of a quantized firing strength (0 = not firing, up to HEAT_LEVELS - 1).
+    static uint16_t heatColor(int32_t level);
+    static const uint8_t HEAT_LEVELS = 16;
+
+    // Draws a membership plot: all columns when dirty, else only the marker's old and
+    // new column, restored from and rendered over the plot's cached background.
+    void drawMembership(const Widget& plot, const WidgetState& state, int16_t marker);
+
+    St7735Panel tft; // Adafruit_ST7735 driver (plus its RAM offsets) to interact with the display.
+#if FUZZY_FRAMEBUFFER
+    FrameBuffer frameBuffer; // Off-screen copy of the screen; all drawing goes here first
+#endif
+#if FUZZY_DMA_FLUSH
+    DmaFlusher dmaFlusher;   // Sends the framebuffer changes in the background
+    bool dmaReady;           // False if the DMA driver could not be set up (blocking flush is used)
+#endif
+    Adafruit_GFX& gfx;       // Drawing target: frameBuffer, or tft when drawing directly
+    FlushStats flushStats;   // Traffic of the last present()
+    DigitAtlas atlas;        // Pre-rasterized glyphs for the numeric fields
+
+    Page page;               // Page currently shown
+    WidgetState widgetStates[MAX_PAGE_WIDGETS]; // What each widget of the page shows
+    float values[SOURCE_COUNT]; // Latest value of each widget source, to redraw on a page switch
+    uint8_t ruleFiring[RULE_GRID_CELLS]; // Latest rule grid firing strengths (0-255)
+    uint8_t memberships[MEMBERSHIP_CELLS]; // Latest input set membership degrees (hundredths)
+    MembershipPlot membershipPlots[MEMBERSHIP_INPUTS]; // Cached membership function backgrounds
+
+    HistoryBuffer history;   // Downsampled soil/pump history for the chart page
+    uint32_t chartColumns;   // Samples drawn on the chart since the page was shown
+    bool hardwareScroll;     // Chart scrolls with the ST7735 scroll registers (else: sweep)
+    uint16_t scrollTop;      // First frame-memory line of the scroll area (TFA) = chart's left edge
+    uint16_t scrollStart;    // Frame-memory line currently shown at the left of the scroll area
 };
 
 #endif // End of include guard
\ No newline at end of file
@@ -0,0 +1,222 @@
+// FuzzyEngine.cpp
+#include "FuzzyEngine.h" // Include the header file we just defined
+
+// Corners the union of the clipped output sets can have: the set points, where an edge
+// meets a clip level, where two edges cross, and the two ends of the range
+static const uint8_t MAX_CORNERS = MODEL_OUTPUT_SETS * 4 + (MODEL_OUTPUT_SETS * 2) * MODEL_OUTPUT_SETS +
+                                   (MODEL_OUTPUT_SETS * 2) * (MODEL_OUTPUT_SETS * 2 - 1) / 2 + 2;
+
+// Sloped side of a trapezoid as the line y = slope * x + offset, between x = from and x = to
+struct Edge {
+  float slope;
+  float offset;
+  float from;
+  float to;
+};
+
+// setMembership function implementation
+float setMembership(const SetPoints& set, float value) {
+  if (value < set.a || value > set.d) {
+    return 0;
+  }
+  if (value < set.b) {
+    return (value - set.a) / (set.b - set.a); // Rising edge (b > a here)
+  }
+  if (value <= set.c) {
+    return 1;
+  }
+  return (set.d - value) / (set.d - set.c);   // Falling edge (d > c here)
+}
+
+// Height of the union of the output sets, each clipped at its level, at x
+static float clippedUnion(const FuzzyModel& model, const float levels[MODEL_OUTPUT_SETS], float x) {
+  float height = 0;
+  for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+    if (levels[set] > height) {
+      height = max(height, min(levels[set], setMembership(model.outputSets[set], x)));
+    }
+  }
+  return height;
+}
+
+// Exact centroid of the clipped union. Between two neighbouring corners the union is one
+// straight line, so its area and moment there follow from its height at two points inside
+// the segment (at a third and two thirds: a vertical edge at a corner doesn't matter).
+static float exactCentroid(const FuzzyModel& model, const float levels[MODEL_OUTPUT_SETS]) {
+  float low, high;
+  modelVariableRange(MODEL_OUTPUT, low, high);
+  float corners[MAX_CORNERS];
+  uint8_t count = 0;
+  corners[count++] = low;
+  corners[count++] = high;
+
+  Edge edges[MODEL_OUTPUT_SETS * 2];
+  uint8_t edgeCount = 0;
+  for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+    if (levels[set] <= 0) continue; // Not fired: not part of the union
+    const SetPoints& points = model.outputSets[set];
+    corners[count++] = points.a;
+    corners[count++] = points.b;
+    corners[count++] = points.c;
+    corners[count++] = points.d;
+    if (points.b > points.a) {
+      float slope = 1 / (points.b - points.a);
+      edges[edgeCount++] = {slope, -slope * points.a, points.a, points.b};
+    }
+    if (points.d > points.c) {
+      float slope = -1 / (points.d - points.c);
+      edges[edgeCount++] = {slope, -slope * points.d, points.c, points.d};
+    }
+  }
+  for (uint8_t i = 0; i < edgeCount; i++) {
+    const Edge& edge = edges[i];
+    for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+      if (levels[set] > 0 && levels[set] < 1) {
+        corners[count++] = (levels[set] - edge.offset) / edge.slope;
+      }
+    }
+    for (uint8_t j = i + 1; j < edgeCount; j++) {
+      if (edges[j].slope != edge.slope) {
+        float x = (edges[j].offset - edge.offset) / (edge.slope - edges[j].slope);
+        if (x > max(edge.from, edges[j].from) && x < min(edge.to, edges[j].to)) {
+          corners[count++] = x;
+        }
+      }
+    }
+  }
+
+  // Insertion sort: a few dozen values, mostly in order already
+  for (uint8_t i = 1; i < count; i++) {
+    float x = constrain(corners[i], low, high);
+    uint8_t j = i;
+    while (j > 0 && corners[j - 1] > x) {
+      corners[j] = corners[j - 1];
+      j--;
+    }
+    corners[j] = x;
+  }
+
+  float area = 0;
+  float moment = 0;
+  for (uint8_t i = 0; i + 1 < count; i++) {
+    float width = corners[i + 1] - corners[i];
+    if (width <= 0) continue;
+    float first = clippedUnion(model, levels, corners[i] + width / 3);
+    float second = clippedUnion(model, levels, corners[i] + width * 2 / 3);
+    float middle = (first + second) / 2;
+    float slope = (second - first) * 3 / width;
+    area += width * middle;
+    moment += width * ((corners[i] + corners[i + 1]) / 2 * middle + slope * width * width / 12);
+  }
+  return area > 0 ? moment / area : 0;
+}
+
+// Centroid of the clipped union sampled from an output table
+static float tableCentroid(const uint8_t (*table)[OUTPUT_TABLE_SAMPLES], const float levels[MODEL_OUTPUT_SETS]) {
+  float low, high;
+  modelVariableRange(MODEL_OUTPUT, low, high);
+  uint8_t clips[MODEL_OUTPUT_SETS];
+  for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+    clips[set] = (uint8_t)lround(constrain(levels[set], 0.0f, 1.0f) * 255);
+  }
+  uint32_t area = 0;
+  uint32_t moment = 0;
+  for (uint8_t i = 0; i < OUTPUT_TABLE_SAMPLES; i++) {
+    uint8_t height = 0;
+    for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+      height = max(height, min(clips[set], table[set][i]));
+    }
+    uint8_t weight = (i == 0 || i == OUTPUT_TABLE_SAMPLES - 1) ? 1 : 2; // Trapezoid rule
+    area += (uint32_t)height * weight;
+    moment += (uint32_t)height * weight * i;
+  }
+  if (area == 0) {
+    return 0;
+  }
+  return low + (high - low) * moment / (area * (float)(OUTPUT_TABLE_SAMPLES - 1));
+}
+
+// fillOutputTable function implementation
+void fillOutputTable(const FuzzyModel& model, uint8_t table[MODEL_OUTPUT_SETS][OUTPUT_TABLE_SAMPLES]) {
+  float low, high;
+  modelVariableRange(MODEL_OUTPUT, low, high);
+  for (uint8_t set = 0; set < MODEL_OUTPUT_SETS; set++) {
+    for (uint8_t i = 0; i < OUTPUT_TABLE_SAMPLES; i++) {
+      float x = low + (high - low) * i / (OUTPUT_TABLE_SAMPLES - 1);
+      table[set][i] = (uint8_t)lround(setMembership(model.outputSets[set], x) * 255);
+    }
+  }
+}
+
+// runInference function implementation
+void runInference(const FuzzyModel& model, const uint8_t (*outputTable)[OUTPUT_TABLE_SAMPLES],
+                  const float inputs[MODEL_INPUTS], InferenceResult& result) {
+  for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+    // A reading past the range (e.g. a DHT22 at 60 degrees C) counts as the range end,
+    // where validateModel() guarantees an edge set at full membership
+    float low, high;
+    modelVariableRange(input, low, high);
+    float value = constrain(inputs[input], low, high);
+    for (uint8_t level = 0; level < MODEL_LEVELS; level++) {
+      result.memberships[input][level] = setMembership(model.inputSets[input][level], value);
+    }
+  }
+
+  float levels[MODEL_OUTPUT_SETS] = {0, 0, 0, 0};
+  for (uint8_t r = 0; r < model.ruleCount; r++) {
+    const RuleMapping& rule = model.rules[r];
+    float strength = 1;
+    for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+      if (rule.inputs[input] != RULE_ANY) {
+        strength = min(strength, result.memberships[input][rule.inputs[input]]);
+      }
+    }
+    levels[rule.output] = max(levels[rule.output], strength);
+  }
+
+  result.pumpPower = outputTable != NULL ? tableCentroid(outputTable, levels) : exactCentroid(model, levels);
+}
+
+#if FUZZY_BENCHMARK
+// Inputs of benchmark step i: each input swept over its range at its own pace
+static void benchmarkInputs(uint32_t i, float inputs[MODEL_INPUTS]) {
+  static const uint8_t STEPS[MODEL_INPUTS] = {7, 13, 29};
+  for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+    float low, high;
+    modelVariableRange(input, low, high);
+    inputs[input] = low + (high - low) * ((i * STEPS[input]) % 101) / 100;
+  }
+}
+
+// benchmarkInference function implementation
+InferenceBenchmark benchmarkInference(const FuzzyModel& model, uint32_t iterations) {
+  InferenceBenchmark benchmark = {iterations, 0, 0, 0};
+  static uint8_t table[MODEL_OUTPUT_SETS][OUTPUT_TABLE_SAMPLES]; // Off the caller's stack
+  fillOutputTable(model, table);
+  float inputs[32][MODEL_INPUTS]; // Generated outside the timed loops
+  float exact[32];
+  InferenceResult result;
+
+  for (uint32_t start = 0; start < iterations; start += 32) {
+    uint32_t batch = min((uint32_t)32, iterations - start);
+    for (uint32_t i = 0; i < batch; i++) {
+      benchmarkInputs(start + i, inputs[i]);
+    }
+    unsigned long t0 = micros(); // Whole batches: one inference is too short to time alone
+    for (uint32_t i = 0; i < batch; i++) {
+      runInference(model, NULL, inputs[i], result);
+      exact[i] = result.pumpPower;
+    }
+    unsigned long t1 = micros();
+    benchmark.exactMicros += t1 - t0;
+    float difference = 0;
+    for (uint32_t i = 0; i < batch; i++) {
+      runInference(model, table, inputs[i], result);
+      difference = max(difference, fabsf(exact[i] - result.pumpPower));
+    }
+    benchmark.tableMicros += micros() - t1;
+    benchmark.maxDifference = max(benchmark.maxDifference, difference);
+  }
+  return benchmark;
+}
+#endif
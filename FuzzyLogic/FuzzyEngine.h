@@ -0,0 +1,58 @@
+// FuzzyEngine.h
+#ifndef FuzzyEngine_h // Include guard to prevent multiple inclusions
+#define FuzzyEngine_h
+
+#include <Arduino.h>
+#include "FuzzyConfig.h"
+#include "FuzzyModel.h"
+
+// Mamdani inference straight on a FuzzyModel: nothing is built, allocated or kept between
+// calls, so the model can be swapped for another one between any two inferences.
+//
+//   1. Fuzzify: the membership degree of every input set.
+//   2. Rules: a rule fires with the minimum (AND) of the degrees of the sets it tests.
+//   3. Each output set is clipped at the strongest rule mapped to it (maximum).
+//   4. Defuzzify: the centroid of the union (maximum) of the clipped output sets.
+//
+// Without an output table the centroid is exact: the union is piecewise linear, so it is
+// integrated segment by segment between its corners. With one (fillOutputTable(), kept
+// with the model in a ModelBlob) the union is sampled at OUTPUT_TABLE_SAMPLES points over
+// the pump power range instead (trapezoid rule): a fixed number of table reads and no
+// sorting, for a result within half a percent of pump power of the exact one.
+
+// Samples of each output set in an output table: one per percent of pump power
+const uint8_t OUTPUT_TABLE_SAMPLES = 101;
+
+// Result of one inference
+struct InferenceResult {
+  float pumpPower;                              // Percent; 0 if no rule fired
+  float memberships[MODEL_INPUTS][MODEL_LEVELS]; // Degree of every input set (0..1)
+};
+
+// Membership degree (0..1) of value in a trapezoid. A vertical edge (a == b or c == d)
+// counts as inside the set.
+float setMembership(const SetPoints& set, float value);
+
+// Samples every output set of model over the pump power range, 255 = full membership.
+void fillOutputTable(const FuzzyModel& model, uint8_t table[MODEL_OUTPUT_SETS][OUTPUT_TABLE_SAMPLES]);
+
+// Runs model on inputs (temperature, humidity, soil moisture). Inputs outside their
+// variable's range are taken at the nearest end of it. outputTable may be NULL (exact
+// centroid).
+void runInference(const FuzzyModel& model, const uint8_t (*outputTable)[OUTPUT_TABLE_SAMPLES],
+                  const float inputs[MODEL_INPUTS], InferenceResult& result);
+
+#if FUZZY_BENCHMARK
+// Time of the same inferences with the exact centroid and with an output table, over a
+// sweep of the input ranges
+struct InferenceBenchmark {
+  uint32_t iterations;
+  unsigned long exactMicros;
+  unsigned long tableMicros;
+  float maxDifference; // Largest pump power difference between the two, percent
+};
+
+InferenceBenchmark benchmarkInference(const FuzzyModel& model, uint32_t iterations);
+#endif
+
+#endif // End of include guard
@@ -20,11 +20,10 @@
  * - DHT22 Sensor (Temperature & Humidity)
  * - Analog Soil Moisture Sensor
  * - Adafruit ST7735 TFT Display
- * - Water Pump (controlled by the output of the fuzzy logic)
+ * - Water Pump (PWM from the output of the fuzzy logic, through a MOSFET or motor driver)
  * 
  * Libraries:
  * - DHT.h (for DHT sensor)
- * - Fuzzy.h (for fuzzy logic operations - specific library assumed)
  * - Adafruit_ST7735.h (for TFT display)
  * - SPI.h (dependency for Adafruit_ST7735)
  * 
@@ -34,15 +33,37 @@
  * - TFT_CS: 5 (TFT Chip Select)
  * - TFT_RST: 4 (TFT Reset)
  * - TFT_DC: 22 (TFT Data/Command)
+ * - PUMP_PWM_PIN: 25 (Pump PWM output)
  * 
  * Author: CE320 - Fuzzy Logic Team
  * Date: May 29, 2025 
  */
 
 #include <DHT.h>
-#include <Fuzzy.h>
 
+#include "FuzzyConfig.h"
 #include "FuzzyDisplay.h" 
+#include "ControlFrame.h"
+#include "TripleBuffer.h"
+#include "FrameGovernor.h"
+#include "FixedFormat.h"
+#include "Telemetry.h"
+#include "LogBuffer.h"
+#include "FlashLog.h"
+#include "SeriesCodec.h"
+#include "Seqlock.h"
+#include "FuzzyModel.h"
+#include "FuzzyEngine.h"
+#include "ModelBlob.h"
+#include "ModelSlot.h"
+#include "CropProfiles.h"
+#include "ProfileSelector.h"
+#include "TuningConsole.h"
+#include "Metrics.h"
+#include "SensorReadings.h"
+#include "DhtCapture.h"
+#include "SensorTasks.h"
+#include "PumpDriver.h"
 
 // --- Sensor and General Defines ---
 #define DHTPIN 13
@@ -54,243 +75,778 @@
 #define TFT_RST   4  
 #define TFT_DC    22
 
-// --- Object Instantiations ---
-DHT dht(DHTPIN, DHTTYPE);
-Fuzzy* fuzzy = new Fuzzy();
-FuzzyDisplay myDisplay(TFT_CS, TFT_DC, TFT_RST);
+// --- Pump Output (LEDC PWM to the pump's MOSFET or motor driver) ---
+#define PUMP_PWM_PIN 25
 
-// --- Fuzzy Logic Definitions ---
-FuzzySet* lowTemp = new FuzzySet(-5, -5, 10, 20);     
-FuzzySet* mediumTemp = new FuzzySet(10, 20, 20, 30);   
-FuzzySet* highTemp = new FuzzySet(20, 30, 45, 45);     
+// --- Page Button (BOOT button on most ESP32 boards, active low) ---
+#define PAGE_BUTTON_PIN 0
 
-FuzzySet* lowHumidity = new FuzzySet(0, 0, 30, 50);     
-FuzzySet* mediumHumidity = new FuzzySet(30, 50, 50, 70); 
-FuzzySet* highHumidity = new FuzzySet(50, 70, 100, 100); 
+// --- Profile Select Jumpers (to GND, binary profile number; none = keep the model) ---
+#define PROFILE_PIN_A 32 // Bit 0
+#define PROFILE_PIN_B 33 // Bit 1
 
-FuzzySet* drySoil = new FuzzySet(0, 0, 20, 35);     
-FuzzySet* moistSoil = new FuzzySet(20, 35, 40, 55);  
-FuzzySet* wetSoil = new FuzzySet(40, 55, 100, 100);  
+// --- Object Instantiations ---
+#if FUZZY_COROUTINES
+DhtCapture dhtCapture(DHTPIN); // Edge-capture DHT22 reader driven by dhtTask
+CoExecutor coExecutor;         // Runs the sensor and inference coroutines
+#else
+DHT dht(DHTPIN, DHTTYPE);
+#endif
+FuzzyDisplay myDisplay(TFT_CS, TFT_DC, TFT_RST);
 
-FuzzySet* noWater = new FuzzySet(0, 0, 0, 15);       
-FuzzySet* lowWater = new FuzzySet(0, 15, 15, 40);  
-FuzzySet* moderateWater = new FuzzySet(15, 40, 40, 60); 
-FuzzySet* fullWater = new FuzzySet(40, 60, 100, 100);  
+// Pump: stalls below 20%, ramps up at 25%/s, runs at least 10 s once started, and stops
+// when its last decision rests on a reading more than 5 s old: the DHT22 (read every 2 s)
+// may miss one read, not two in a row
+PumpDriver pumpDriver(PUMP_PWM_PIN, 20.0, 25.0, 10000, 5000);
 
-FuzzyInput* temperatureInput = new FuzzyInput(1);
-FuzzyInput* humidityInput = new FuzzyInput(2);
-FuzzyInput* soilMoistureInput = new FuzzyInput(3);
-FuzzyOutput* pumpPowerOutput = new FuzzyOutput(1);
+// --- Fuzzy Logic Definitions ---
+// The built-in controller: sets (trapezoid points a, b, c, d) and rules as one constant
+// ModelBlob. It stays in flash and inference reads it in place, so nothing is allocated
+// or constructed at boot. It has no output table (the exact centroid is used) and no
+// checksum: setup() checks it with validateModel().
+const ModelBlob DEFAULT_MODEL = {
+  MODEL_BLOB_MAGIC, MODEL_BLOB_VERSION, 0, sizeof(ModelBlob),
+  {
+    {
+      {{-5, -5, 10, 20}, {10, 20, 20, 30}, {20, 30, 45, 45}},     // Temperature: low, medium, high
+      {{0, 0, 30, 50}, {30, 50, 50, 70}, {50, 70, 100, 100}},     // Humidity: low, medium, high
+      {{0, 0, 20, 35}, {20, 35, 40, 55}, {40, 55, 100, 100}}      // Soil moisture: dry, moist, wet
+    },
+    {{0, 0, 0, 15}, {0, 15, 15, 40}, {15, 40, 40, 60}, {40, 60, 100, 100}}, // Pump power: none, low, moderate, full
+    {
+      // Each rule maps combinations of input conditions (temperature, humidity, soil
+      // moisture) to an output action (pump power); RULE_ANY leaves an input out.
+
+      // Rule 1: Nếu Temp = Low, Humid = Low, Soil = Dry -> Tưới ít
+      {{SET_LOW, SET_LOW, SET_DRY}, WATER_LOW},
+
+      // Rule 2: Nếu Temp = Low, Humid = Medium hoặc High -> Không tưới
+      {{SET_LOW, SET_MEDIUM, RULE_ANY}, WATER_NONE}, // Rule for Medium Humidity
+      {{SET_LOW, SET_HIGH, RULE_ANY}, WATER_NONE},   // Rule for High Humidity
+
+      // Rule 3: Nếu Temp = Low, Soil = Moist -> Không tưới
+      {{SET_LOW, RULE_ANY, SET_MOIST}, WATER_NONE},
+
+      // Rule 4: Nếu Soil = Wet -> Không tưới
+      {{RULE_ANY, RULE_ANY, SET_WET}, WATER_NONE}, // This rule only considers soil moisture
+
+      // Rule 5: Nếu Temp = Medium, Humid = Low, Soil = Dry -> Tưới đầy đủ
+      {{SET_MEDIUM, SET_LOW, SET_DRY}, WATER_FULL},
+
+      // Rule 6: Nếu Temp = Medium, Humid = Low, Soil = Moist -> Tưới vừa
+      {{SET_MEDIUM, SET_LOW, SET_MOIST}, WATER_MODERATE},
+
+      // Rule 7: Nếu Temp = Medium, Humid = Medium, Soil = Dry -> Tưới vừa
+      {{SET_MEDIUM, SET_MEDIUM, SET_DRY}, WATER_MODERATE},
+
+      // Rule 8: Nếu Temp = Medium, Humid = Medium, Soil = Moist -> Tưới ít
+      {{SET_MEDIUM, SET_MEDIUM, SET_MOIST}, WATER_LOW},
+
+      // Rule 9: Nếu Temp = Medium, Humid = High, Soil = Dry -> Tưới ít
+      {{SET_MEDIUM, SET_HIGH, SET_DRY}, WATER_LOW},
+
+      // Rule 10: Nếu Temp = Medium, Humid = High, Soil = Moist -> Không tưới
+      {{SET_MEDIUM, SET_HIGH, SET_MOIST}, WATER_NONE},
+
+      // Rule 11: Nếu Temp = High, Soil = Dry -> Tưới đầy đủ
+      {{SET_HIGH, RULE_ANY, SET_DRY}, WATER_FULL},
+
+      // Rule 12: Nếu Temp = High, Humid = High, Soil = Moist -> Tưới ít
+      {{SET_HIGH, SET_HIGH, SET_MOIST}, WATER_LOW},
+
+      // Rule 13: Nếu Temp = High, Humid = Low hoặc Medium, Soil = Moist -> Tưới vừa
+      {{SET_HIGH, SET_LOW, SET_MOIST}, WATER_MODERATE},
+      {{SET_HIGH, SET_MEDIUM, SET_MOIST}, WATER_MODERATE}
+    },
+    14 // Number of rules above
+  },
+  {}, // No output table
+  0   // Not sealed
+};
 
 
 // --- Timing Variables for Non-Blocking Operation ---
 unsigned long lastDhtReadTime = 0;
 const unsigned long dhtReadInterval = 2000; // Read DHT every 2 seconds (DHT22 recommended)
+const unsigned long dhtWarmupMillis = 1000; // No DHT22 read in the first second after power-up
 
 unsigned long lastSoilReadTime = 0; // Stores the last time soil moisture was read
 const unsigned long soilReadInterval = 500; // Defines the interval for reading soil moisture (in milliseconds)
 
-unsigned long lastLogicDisplayTime = 0; // Stores the last time fuzzy logic was processed and display updated
-const unsigned long logicDisplayInterval = 1000; // Defines the interval for logic processing and display updates (in milliseconds)
-
-// --- Global Variables to Store Latest Sensor Data ---
-float currentTemperature = NAN; // Stores the latest temperature reading. NAN indicates no valid reading yet.
-float currentHumidity = NAN;    // Stores the latest humidity reading. NAN indicates no valid reading yet.
-float currentSoilMoisture = NAN; // Stores the latest soil moisture reading. NAN indicates no valid reading yet.
-float currentPumpPower = 0;     // Stores the calculated pump power. Initialized to 0.
-
-
-// --- Fuzzy Rule Setup Functions ---
-// This function defines the fuzzy rules that govern the irrigation system's behavior.
-// Each rule maps combinations of input conditions (temperature, humidity, soil moisture)
-// to an output action (pump power).
-void setupFuzzyRules() {
-  // Rule 1: Nếu Temp = Low, Humid = Low, Soil = Dry -> Tưới ít
-  addRule(lowTemp, lowHumidity, drySoil, lowWater);
-
-  // Rule 2: Nếu Temp = Low, Humid = Medium hoặc High -> Không tưới
-  addRule(lowTemp, mediumHumidity, NULL, noWater); // Rule for Medium Humidity
-  addRule(lowTemp, highHumidity, NULL, noWater);  // Rule for High Humidity
-
-  // Rule 3: Nếu Temp = Low, Soil = Moist -> Không tưới
-  addRule(lowTemp, NULL, moistSoil, noWater);
-
-  // Rule 4: Nếu Soil = Wet -> Không tưới
-  addRule(NULL, NULL, wetSoil, noWater); // This rule only considers soil moisture
-
-  // Rule 5: Nếu Temp = Medium, Humid = Low, Soil = Dry -> Tưới đầy đủ
-  addRule(mediumTemp, lowHumidity, drySoil, fullWater);
-
-  // Rule 6: Nếu Temp = Medium, Humid = Low, Soil = Moist -> Tưới vừa
-  addRule(mediumTemp, lowHumidity, moistSoil, moderateWater);
-
-  // Rule 7: Nếu Temp = Medium, Humid = Medium, Soil = Dry -> Tưới vừa
-  addRule(mediumTemp, mediumHumidity, drySoil, moderateWater);
-
-  // Rule 8: Nếu Temp = Medium, Humid = Medium, Soil = Moist -> Tưới ít
-  addRule(mediumTemp, mediumHumidity, moistSoil, lowWater);
-
-  // Rule 9: Nếu Temp = Medium, Humid = High, Soil = Dry -> Tưới ít
-  addRule(mediumTemp, highHumidity, drySoil, lowWater);
-
-  // Rule 10: Nếu Temp = Medium, Humid = High, Soil = Moist -> Không tưới
-  addRule(mediumTemp, highHumidity, moistSoil, noWater);
-
-  // Rule 11: Nếu Temp = High, Soil = Dry -> Tưới đầy đủ
-  addRule(highTemp, NULL, drySoil, fullWater);
-
-  // Rule 12: Nếu Temp = High, Humid = High, Soil = Moist -> Tưới ít
-  addRule(highTemp, highHumidity, moistSoil, lowWater);
-
-  // Rule 13: Nếu Temp = High, Humid = Low hoặc Medium, Soil = Moist -> Tưới vừa
-  addRule(highTemp, lowHumidity, moistSoil, moderateWater);
-  addRule(highTemp, mediumHumidity, moistSoil, moderateWater);
-}
-
-void addRule(FuzzySet* tempSet, FuzzySet* humidSet, FuzzySet* soilSet, FuzzySet* outputSet) {
-  FuzzyRuleAntecedent* antecedent = new FuzzyRuleAntecedent();
-  int inputCount = (tempSet != NULL) + (humidSet != NULL) + (soilSet != NULL);
-  
-  if (inputCount == 0) {
-    Serial.println("Error: Rule needs at least one input set");
-    return;
-  }
-  
-  if (inputCount == 1) {
-    if (tempSet != NULL) antecedent->joinSingle(tempSet);
-    else if (humidSet != NULL) antecedent->joinSingle(humidSet);
-    else if (soilSet != NULL) antecedent->joinSingle(soilSet);
-  } 
-  else if (inputCount == 2) {
-    if (tempSet != NULL && humidSet != NULL) {
-      antecedent->joinWithAND(tempSet, humidSet);
-    } else if (tempSet != NULL && soilSet != NULL) {
-      antecedent->joinWithAND(tempSet, soilSet);
-    } else if (humidSet != NULL && soilSet != NULL) {
-      antecedent->joinWithAND(humidSet, soilSet);
+unsigned long lastLogicTime = 0; // Stores the last time fuzzy logic was processed
+const unsigned long logicInterval = 1000; // Defines the interval for logic processing (in milliseconds)
+
+// --- Boot Timing ---
+bool awaitingFirstDecision = true;   // No inference with all inputs valid yet (inference side)
+unsigned long displayReadyMillis = 0; // When setup() had the display initialized
+
+// Display refresh, independent of the logic interval: at most one frame per renderInterval,
+// and at most renderBudget milliseconds of SPI time per second (see FrameGovernor.h)
+const unsigned long renderInterval = 1000;
+const unsigned long renderBudget = 250;
+FrameGovernor frameGovernor(renderInterval, renderBudget);
+
+bool pageButtonPressed = false;          // Debounced state of the page button
+unsigned long lastPageButtonChange = 0;  // Stores the last time the page button state changed
+const unsigned long pageButtonDebounce = 50; // Ignore button bounces shorter than this (in milliseconds)
+
+// --- Latest Sensor Data ---
+// All readings and the pump output, each with its update time, behind a seqlock.
+// Written only by the acquisition/inference side; any task or ISR can take a consistent
+// copy with sensorState.read() (or tryRead() from an ISR) without disabling interrupts.
+// A failed DHT read keeps the previous value and timestamp, so its age shows staleness.
+Seqlock<SensorReadings> sensorState;
+
+// --- Inference -> Rendering Handoff ---
+// Lock-free single-producer/single-consumer channel carrying the latest ControlFrame.
+// In dual-core mode the producer is the acquisition task (core 0) and the consumer the
+// render task (core 1); in single-core mode both sides run in loop().
+TripleBuffer<ControlFrame> frameChannel;
+
+// --- Sensor-to-Pixel Latency Statistics (updated by the rendering side) ---
+unsigned long lastLatencyMicros = 0; // Latency of the last rendered frame
+unsigned long maxLatencyMicros = 0;  // Worst latency seen since boot
+unsigned long latencySumMicros = 0;  // Running sum for the average over latencyWindow frames
+unsigned int latencyCount = 0;
+unsigned long avgLatencyMicros = 0;  // Average latency of the last completed window
+const unsigned int latencyWindow = 10; // Number of frames averaged per window
+
+// --- Serial Log Output ---
+// Log records are queued here by the rendering side and sent by drainLog() whenever the
+// UART has room, so a full TX buffer never blocks inference or the display. When the
+// queue is full the oldest record is replaced (DROP_NEWEST keeps the queued ones instead).
+LogBuffer logBuffer(LogBuffer::DROP_OLDEST);
+
+// --- Runtime Metrics ---
+// Ids of the sketch's metrics, in the order of STATS below
+enum Stat {
+  STAT_INFERENCES,
+  STAT_INPUTS_INVALID,
+  STAT_DHT_FAILURES,
+  STAT_FRAMES_RENDERED,
+  STAT_FRAMES_SKIPPED,
+  STAT_UPDATES_COALESCED,
+  STAT_LOOP_OVERRUNS,
+  STAT_LOG_DROPPED,
+  STAT_PUMP_POWER,
+  STAT_INFERENCE_MICROS,
+  STAT_LATENCY_MICROS,
+  STAT_DISPLAY_MICROS,
+  STAT_LOOP_MICROS,
+  STAT_BOOT_DECISION_MILLIS,
+  STAT_PUMP_OUTPUT,
+  STAT_PUMP_STALE_STOPS,
+  STAT_ACTUATION_MICROS,
+  STAT_COUNT
+};
+
+const MetricDefinition STATS[STAT_COUNT] = {
+  {"fuzzy_inferences_total", "Inferences run", METRIC_COUNTER},
+  {"fuzzy_inputs_invalid_total", "Inference rounds skipped for a missing reading", METRIC_COUNTER},
+  {"fuzzy_dht_failures_total", "Failed DHT reads (previous values kept)", METRIC_COUNTER},
+  {"fuzzy_frames_rendered_total", "Display frames drawn", METRIC_COUNTER},
+  {"fuzzy_frames_skipped_total", "Due frames deferred by the SPI budget", METRIC_COUNTER},
+  {"fuzzy_updates_coalesced_total", "Published frames replaced before being drawn", METRIC_COUNTER},
+  {"fuzzy_loop_overruns_total", "Loop or task passes longer than loopOverrunMicros", METRIC_COUNTER},
+  {"fuzzy_log_dropped_total", "Serial log records lost", METRIC_COUNTER},
+  {"fuzzy_pump_power_tenths", "Defuzzified pump power, tenths of a percent", METRIC_GAUGE},
+  {"fuzzy_inference_us", "Time of one inference (fuzzify, rules, defuzzify)", METRIC_HISTOGRAM},
+  {"fuzzy_latency_us", "Sensor read to end of display update", METRIC_HISTOGRAM},
+  {"fuzzy_display_us", "Time of one display update", METRIC_HISTOGRAM},
+  {"fuzzy_loop_us", "Work time of one loop() pass (task pass in dual-core mode)", METRIC_HISTOGRAM},
+  {"fuzzy_boot_decision_ms", "Boot to the first pump decision on valid inputs", METRIC_GAUGE},
+  {"fuzzy_pump_output_tenths", "Pump PWM power after ramp and minimum on-time, tenths of a percent", METRIC_GAUGE},
+  {"fuzzy_pump_stale_stops_total", "Pump stops for lack of a decision on fresh readings", METRIC_COUNTER},
+  {"fuzzy_actuation_us", "Sensor read to pump PWM update", METRIC_HISTOGRAM}
+};
+
+// Updated from both sides without locks; dumped by the console's "metrics" command
+MetricsRegistry metrics(STATS, STAT_COUNT);
+const unsigned long loopOverrunMicros = 50000; // A pass taking longer is counted as an overrun
+
+// --- Controller Profiles ---
+// Ids of the compiled-in models, in the order of PROFILES below (and the jumper numbers)
+enum Profile {
+  PROFILE_DEFAULT,
+  PROFILE_TOMATO,
+  PROFILE_SUCCULENT,
+  PROFILE_SEEDLING,
+  PROFILE_COUNT
+};
+
+// Every blob stays in flash; selecting one only swaps a pointer
+const ModelProfile PROFILES[PROFILE_COUNT] = {
+  {"default", &DEFAULT_MODEL},
+  {"tomato", &TOMATO_MODEL},
+  {"succulent", &SUCCULENT_MODEL},
+  {"seedling", &SEEDLING_MODEL}
+};
+
+// Profile schedule over uptime, used if profileScheduleEnabled: e.g. seedlings from
+// sowing (power-up) and tomatoes once they are planted out three weeks later
+const bool profileScheduleEnabled = false;
+const ProfileStep PROFILE_SCHEDULE[] = {
+  {0, PROFILE_SEEDLING},
+  {21 * 24, PROFILE_TOMATO}
+};
+
+const uint8_t PROFILE_PINS[] = {PROFILE_PIN_A, PROFILE_PIN_B};
+ProfileSelector profileSelector(PROFILE_PINS, sizeof(PROFILE_PINS),
+                                PROFILE_SCHEDULE, profileScheduleEnabled ? sizeof(PROFILE_SCHEDULE) / sizeof(ProfileStep) : 0);
+
+// --- Rule Base Tuning ---
+// Inference runs whatever model modelSlot points at: a profile, the blob saved in the
+// "model" partition, or a model edited on the serial console (built in one of the slot's
+// RAM buffers). The console is the only writer; a swap takes effect at the next inference.
+ModelSlot modelSlot;
+TuningConsole tuningConsole(modelSlot, logBuffer, metrics);
+
+#if FUZZY_MODEL_STORE
+PartitionFlash modelStore("model"); // Holds one ModelBlob, mapped in place at boot
+#endif
+
+#if FUZZY_FLASH_LOG
+// --- Flash Data Log ---
+// One sample per flashLogInterval goes to the circular log in the "datalog" partition.
+// Samples are compressed (SeriesCodec) and programmed one 256-byte page at a time, about
+// 140 per page (~25 min) on a steady series; a sector erase comes every 6 hours or so.
+PartitionFlash flashStore("datalog");
+FlashLog flashLog(flashStore);
+const unsigned long flashLogInterval = 10000; // Milliseconds between logged samples
+unsigned long lastFlashLogTime = 0;
+#endif
+
+#if FUZZY_DUAL_CORE
+TaskHandle_t acquisitionTaskHandle = NULL;
+TaskHandle_t renderTaskHandle = NULL;
+#endif
+
+
+// Gives the input sets of a model to the membership page
+void showModelSets(const FuzzyModel& model) {
+  for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+    for (uint8_t level = 0; level < MODEL_LEVELS; level++) {
+      const SetPoints& set = model.inputSets[input][level];
+      myDisplay.setMembershipSet(input, level, set.a, set.b, set.c, set.d);
     }
-  } 
-  else if (inputCount == 3) {
-    FuzzyRuleAntecedent* tempHumid = new FuzzyRuleAntecedent(); // Intermediate antecedent
-    tempHumid->joinWithAND(tempSet, humidSet);
-    antecedent->joinWithAND(tempHumid, soilSet); // Then AND with the third
   }
-
-  FuzzyRuleConsequent* consequent = new FuzzyRuleConsequent();
-  consequent->addOutput(outputSet);
-
-  static int ruleNum = 1; // Ensures unique rule numbers if library requires
-  FuzzyRule* rule = new FuzzyRule(ruleNum++, antecedent, consequent);
-  fuzzy->addFuzzyRule(rule);
 }
 
 void setup() {
   Serial.begin(115200);
+  if (!pumpDriver.begin()) { // First, so the pump is held off from the start
+    Serial.println("Error: No PWM on the pump pin, pump disabled");
+  }
+#if !FUZZY_COROUTINES
   dht.begin();
-  delay(1000); // DHT sensor can take a moment to stabilize after begin
+#endif
+#if FUZZY_FAST_START
+  // The DHT22 warms up while the rest of setup() runs; its first read waits until dhtReadyMillis
+  const unsigned long dhtReadyMillis = millis() + dhtWarmupMillis;
+#else
+  delay(dhtWarmupMillis); // DHT sensor can take a moment to stabilize after begin
+#endif
 
   // --- Fuzzy Logic Setup ---
-  temperatureInput->addFuzzySet(lowTemp);
-  temperatureInput->addFuzzySet(mediumTemp);
-  temperatureInput->addFuzzySet(highTemp);
-  fuzzy->addFuzzyInput(temperatureInput);
-
-  humidityInput->addFuzzySet(lowHumidity);
-  humidityInput->addFuzzySet(mediumHumidity);
-  humidityInput->addFuzzySet(highHumidity);
-  fuzzy->addFuzzyInput(humidityInput);
-
-  soilMoistureInput->addFuzzySet(drySoil);
-  soilMoistureInput->addFuzzySet(moistSoil);
-  soilMoistureInput->addFuzzySet(wetSoil);
-  fuzzy->addFuzzyInput(soilMoistureInput);
-
-  pumpPowerOutput->addFuzzySet(noWater);
-  pumpPowerOutput->addFuzzySet(lowWater);
-  pumpPowerOutput->addFuzzySet(moderateWater);
-  pumpPowerOutput->addFuzzySet(fullWater);
-  fuzzy->addFuzzyOutput(pumpPowerOutput);
-  
-  setupFuzzyRules();
+  for (uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+    char modelError[MODEL_ERROR_LENGTH];
+    if (!validateModel(PROFILES[profile].blob->model, modelError)) {
+      Serial.print("Error: Profile "); Serial.print(PROFILES[profile].name); Serial.print(": ");
+      Serial.println(modelError);
+    }
+  }
+#if FUZZY_MODEL_STORE
+  if (!modelStore.begin()) {
+    Serial.println("Error: No \"model\" flash partition, models can't be saved");
+  }
+  tuningConsole.begin(PROFILES, PROFILE_COUNT, &modelStore); // Runs the stored model if there is a valid one
+#else
+  tuningConsole.begin(PROFILES, PROFILE_COUNT, NULL);
+#endif
+  uint8_t jumperedProfile = profileSelector.begin(millis());
+  if (jumperedProfile != ProfileSelector::NONE) {
+    tuningConsole.selectProfile(jumperedProfile); // Jumpers win over the stored model
+  }
 
   // --- Display Setup ---
   myDisplay.begin();      
+  showModelSets(tuningConsole.model());
   myDisplay.drawLayout(); 
+  displayReadyMillis = millis();
+  pinMode(PAGE_BUTTON_PIN, INPUT_PULLUP);
+
+#if FUZZY_FLASH_LOG
+  if (!flashStore.begin() || !flashLog.begin()) {
+    Serial.println("Error: No usable \"datalog\" flash partition, flash log disabled");
+  }
+#endif
+
+#if FUZZY_BENCHMARK
+  // Fixed-point formatter vs Print::print(float, 1), same readings, text discarded
+  FormatBenchmark format = benchmarkFormatting(2000);
+  Serial.print("Format "); Serial.print(format.iterations); Serial.print(" readings: fixed-point ");
+  Serial.print(format.fixedMicros); Serial.print("us, print(float, 1) ");
+  Serial.print(format.printMicros); Serial.println("us");
+
+  // Inference with the exact centroid vs the sampled output table, same inputs
+  InferenceBenchmark inference = benchmarkInference(DEFAULT_MODEL.model, 1000);
+  Serial.print("Inference "); Serial.print(inference.iterations); Serial.print(" runs: exact ");
+  Serial.print(inference.exactMicros); Serial.print("us, output table ");
+  Serial.print(inference.tableMicros); Serial.print("us, max difference ");
+  Serial.print(inference.maxDifference, 2); Serial.println("%");
+
+  // Flash log compression: a synthetic day of samples, in flash-page-sized blocks
+  SeriesBenchmark series = benchmarkSeriesCodec(8640, FlashLog::PAGE_BYTES - FlashLog::BLOCK_HEADER_BYTES);
+  char seriesLine[96];
+  char* q = appendText("Series ", seriesLine);
+  q = formatUnsigned(series.samples, q);
+  q = appendText(" samples: ", q);
+  q = formatTenths(series.bytes * 10 / series.samples, q);
+  q = appendText(" bytes/sample, encode ", q);
+  q = formatUnsigned(series.encodeMicros * 1000 / series.samples, q);
+  q = appendText("ns/sample, decode ", q);
+  q = formatUnsigned(series.decodeMicros * 1000 / series.samples, q);
+  appendText("ns/sample", q);
+  Serial.println(seriesLine);
+#endif
   
-  // Initialize last read times to ensure first read happens quickly if desired,
-  // or use 0 to adhere strictly to the first interval.
-  // Setting them to 'millis() - interval' would trigger an immediate first read.
-  // For simplicity, we'll let the first interval pass.
-  lastDhtReadTime = millis(); 
-  lastSoilReadTime = millis();
-  lastLogicDisplayTime = millis();
+#if FUZZY_FAST_START
+  // First reads as soon as each sensor allows: the soil now, the DHT22 at the end of its
+  // warm-up (now if setup() took longer). Inference runs once all inputs are valid.
+  long warmupLeft = (long)(dhtReadyMillis - millis());
+  unsigned long firstDhtDelay = warmupLeft > 0 ? warmupLeft : 0;
+  unsigned long firstSoilDelay = 0;
+#else
+  // Every task waits one full interval before its first run
+  unsigned long firstDhtDelay = dhtReadInterval;
+  unsigned long firstSoilDelay = soilReadInterval;
+#endif
+  lastDhtReadTime = millis() + firstDhtDelay - dhtReadInterval; 
+  lastSoilReadTime = millis() + firstSoilDelay - soilReadInterval;
+  lastLogicTime = millis();
+
+#if FUZZY_COROUTINES
+  // Same schedule as the interval tasks, written as linear coroutines
+  if (!coExecutor.spawn(dhtTask(dhtCapture, sensorState, dhtReadInterval, firstDhtDelay)) ||
+      !coExecutor.spawn(soilTask(SOIL_MOISTURE_PIN, sensorState, soilReadInterval, firstSoilDelay)) ||
+      !coExecutor.spawn(periodicTask(inferenceStep, logicInterval, FUZZY_FAST_START ? inputsComplete : NULL))) {
+    Serial.println("Error: Not enough coroutine frame slots");
+  }
+#endif
+
+#if FUZZY_DUAL_CORE
+  // Render task first so it is already waiting when the first frame is published.
+  // Core 1 also runs loop(), which is deleted below; core 0 gets sensors + inference.
+  xTaskCreatePinnedToCore(renderTask, "render", 4096, NULL, 1, &renderTaskHandle, 1);
+  xTaskCreatePinnedToCore(acquisitionTask, "acquire", 4096, NULL, 2, &acquisitionTaskHandle, 0);
+#endif
 }
 
-void loop() {
-  unsigned long currentTime = millis(); // Get current time once per loop
-
-  // --- Task 1: Read DHT Sensor (Temperature and Humidity) ---
+#if !FUZZY_COROUTINES
+// --- Task 1: Read DHT Sensor (Temperature and Humidity) ---
+void readDhtSensor(unsigned long currentTime) {
   if (currentTime - lastDhtReadTime >= dhtReadInterval) {
     lastDhtReadTime = currentTime;
     float temp = dht.readTemperature();
     float humid = dht.readHumidity();
 
+    SensorReadings& readings = sensorState.beginWrite();
     if (!isnan(temp)) {
-      currentTemperature = temp;
+      readings.temperature = temp;
+      readings.temperatureMillis = currentTime;
     }
     if (!isnan(humid)) {
-      currentHumidity = humid;
+      readings.humidity = humid;
+      readings.humidityMillis = currentTime;
+    }
+    if (isnan(temp) || isnan(humid)) {
+      readings.dhtFailures++;
+    }
+    if (!isnan(temp) || !isnan(humid)) {
+      readings.sampleMicros = micros(); // Only a stored value starts the latency clock (as in dhtTask)
     }
+    sensorState.endWrite();
     // Serial.println("DHT Updated"); // For debugging
   }
+}
 
-  // --- Task 2: Read Soil Moisture Sensor ---
+// --- Task 2: Read Soil Moisture Sensor ---
+void readSoilSensor(unsigned long currentTime) {
   if (currentTime - lastSoilReadTime >= soilReadInterval) {
     lastSoilReadTime = currentTime;
     int soilMoistureRaw = analogRead(SOIL_MOISTURE_PIN);
-    // Convert raw analog reading to percentage.
-    // Assumes higher raw value means drier soil.
-    // 4095.0 is the max ADC value (12-bit for ESP32).
-    float calculatedSoilMoisture = (1.0 - (soilMoistureRaw / 4095.0)) * 100.0; 
-    
-    // Clamp values based on raw readings
-    if (soilMoistureRaw >= 4095) calculatedSoilMoisture = 0; 
-    // For typical resistive sensors, raw value 0 is very wet (100%)
-    // The formula (1.0 - (0 / 4095.0)) * 100.0 gives 100.
-    
-    // Ensure calculatedSoilMoisture stays within 0-100 range if needed after formula
-    currentSoilMoisture = constrain(calculatedSoilMoisture, 0.0, 100.0);
+    SensorReadings& readings = sensorState.beginWrite();
+    readings.soilMoisture = soilPercentFromRaw(soilMoistureRaw); // Convert raw analog reading to percentage
+    readings.soilMoistureMillis = currentTime;
+    readings.sampleMicros = micros();
+    sensorState.endWrite();
     // Serial.println("Soil Updated"); // For debugging
   }
+}
+
+// Runs the interval-based sensor tasks and, every logicInterval, inferenceStep(). In fast
+// start mode the first inference runs as soon as all inputs are valid.
+void pollTasks(unsigned long currentTime) {
+  readDhtSensor(currentTime);
+  readSoilSensor(currentTime);
+  if (currentTime - lastLogicTime >= logicInterval || (FUZZY_FAST_START && awaitingFirstDecision && inputsComplete(NULL))) {
+    lastLogicTime = currentTime;
+    inferenceStep(currentTime);
+  }
+}
+#endif
+
+// True once every input has a valid reading (the context is unused: periodicTask's early test)
+bool inputsComplete(void*) {
+  SensorReadings readings = sensorState.read();
+  return !isnan(readings.temperature) && !isnan(readings.humidity) && !isnan(readings.soilMoisture);
+}
+
+// --- Task 3: Process Fuzzy Logic and Publish the Result to frameChannel ---
+void runFuzzyLogic(unsigned long currentTime) {
+  SensorReadings readings = sensorState.read(); // One consistent generation of all inputs
+  ControlFrame& frame = frameChannel.back();
+  // Console swaps take effect between two inferences: the model stays valid until the next acquire()
+  const ModelBlob* model = modelSlot.acquire(frame.modelVersion);
+  frame.inferenceMicros = 0;
+  // Check if all sensor data is valid before using
+  frame.inputsValid = !isnan(readings.temperature) && !isnan(readings.humidity) && !isnan(readings.soilMoisture);
+  if (frame.inputsValid) {
+    const float inputs[MODEL_INPUTS] = {readings.temperature, readings.humidity, readings.soilMoisture};
+    InferenceResult result;
+    unsigned long inferenceStart = micros();
+    runInference(*model, inputs, result);
+    readings.pumpPower = result.pumpPower;
+    frame.inferenceMicros = max(micros() - inferenceStart, 1UL); // 0 means "no inference"
+    // Straight to the pump, before anything else: the latency is the sample's age plus inference.
+    // Freshness goes by the oldest input: a failing DHT22 keeps its last values and timestamps.
+    unsigned long inputAgeMillis = max(readingAge(readings.temperatureMillis, currentTime),
+                                       max(readingAge(readings.humidityMillis, currentTime),
+                                           readingAge(readings.soilMoistureMillis, currentTime)));
+    metrics.observe(STAT_ACTUATION_MICROS, pumpDriver.command(readings.pumpPower, readings.sampleMicros, inputAgeMillis));
+    metrics.add(STAT_INFERENCES);
+    metrics.observe(STAT_INFERENCE_MICROS, frame.inferenceMicros);
+    metrics.set(STAT_PUMP_POWER, toTenths(readings.pumpPower));
+    fillRuleGrid(frame, result);
+    fillMemberships(frame, result);
+    if (awaitingFirstDecision) {
+      awaitingFirstDecision = false;
+      metrics.set(STAT_BOOT_DECISION_MILLIS, currentTime); // millis() counts from boot
+    }
+
+    SensorReadings& shared = sensorState.beginWrite();
+    shared.pumpPower = readings.pumpPower;
+    shared.pumpPowerMillis = currentTime;
+    sensorState.endWrite();
+  }
+  frame.temperature = readings.temperature;
+  frame.humidity = readings.humidity;
+  frame.soilMoisture = readings.soilMoisture;
+  frame.pumpPower = readings.pumpPower;
+  frame.sampleMicros = readings.sampleMicros;
+  metrics.set(STAT_DHT_FAILURES, readings.dhtFailures);
+  if (!frame.inputsValid) {
+    metrics.add(STAT_INPUTS_INVALID);
+    memset(frame.ruleFiring, 0, sizeof(frame.ruleFiring)); // Nothing fired this round
+    memset(frame.memberships, MEMBERSHIP_UNKNOWN, sizeof(frame.memberships));
+  }
+  frameChannel.publish();
+  frameGovernor.noteUpdate(); // After publish(): a frame the governor admits can be fetched
+}
+
+// Moves the pump output on between inferences (ramp, minimum on-time, freshness bound).
+// Runs on the inference side, every pass.
+void pollPump() {
+  pumpDriver.update(micros());
+  metrics.set(STAT_PUMP_OUTPUT, toTenths(pumpDriver.output()));
+  metrics.set(STAT_PUMP_STALE_STOPS, pumpDriver.staleStops());
+}
+
+// Firing strength of every temperature x humidity x soil set combination, from the
+// memberships of the inference: the AND (minimum) a rule on those three sets would fire
+// with. No second inference is run.
+void fillRuleGrid(ControlFrame& frame, const InferenceResult& result) {
+  uint8_t cell = 0;
+  for (uint8_t t = 0; t < RULE_GRID_LEVELS; t++) {
+    float tempMembership = result.memberships[0][t];
+    for (uint8_t h = 0; h < RULE_GRID_LEVELS; h++) {
+      float tempHumid = min(tempMembership, result.memberships[1][h]);
+      for (uint8_t s = 0; s < RULE_GRID_LEVELS; s++) {
+        float strength = min(tempHumid, result.memberships[2][s]);
+        frame.ruleFiring[cell++] = (uint8_t)lround(constrain(strength, 0.0f, 1.0f) * 255);
+      }
+    }
+  }
+}
+
+// Membership degree of every input set in the inference, in hundredths for the
+// membership page
+void fillMemberships(ControlFrame& frame, const InferenceResult& result) {
+  for (uint8_t input = 0; input < MEMBERSHIP_INPUTS; input++) {
+    for (uint8_t level = 0; level < RULE_GRID_LEVELS; level++) {
+      float membership = result.memberships[input][level];
+      frame.memberships[input * RULE_GRID_LEVELS + level] = (uint8_t)lround(constrain(membership, 0.0f, 1.0f) * 100);
+    }
+  }
+}
+
+// Inference followed by handing the new frame to the rendering side
+void inferenceStep(unsigned long currentTime) {
+  runFuzzyLogic(currentTime);
+#if FUZZY_DUAL_CORE
+  xTaskNotifyGive(renderTaskHandle); // Wake the render task; the frame itself goes through frameChannel
+#endif
+  // Single core: loop() draws it with pollRender() when the frame governor allows
+}
+
+// Draws the latest frame if the frame governor admits one now. Frames published since the
+// last one drawn are coalesced: only the newest is fetched from frameChannel.
+void pollRender(unsigned long currentTime) {
+  if (frameGovernor.beginFrame(currentTime) && frameChannel.fetch()) {
+    renderFrame(frameChannel.front());
+  }
+}
+
+// --- Task 4: Update Display and Serial Log from a Frame ---
+void renderFrame(const ControlFrame& frame) {
+  // Update the display with the latest processed values.
+  // The display library already handles NANs (e.g. initial readings) by printing "---"
+  unsigned long displayStart = micros();
+  myDisplay.setRuleFiring(frame.ruleFiring);
+  myDisplay.setMemberships(frame.memberships);
+  myDisplay.updateValues(frame.temperature, frame.humidity, frame.soilMoisture, frame.pumpPower);
+  unsigned long displayMicros = micros() - displayStart;
+
+  // Charge the frame's SPI time to the display budget
+#if FUZZY_DMA_FLUSH
+  // The transfer runs after updateValues() has returned: estimate it at the SPI clock
+  frameGovernor.endFrame(displayMicros + (unsigned long)((uint64_t)myDisplay.lastFlushStats().bytes * 8000000ULL / TFT_SPI_HZ));
+#else
+  frameGovernor.endFrame(displayMicros); // Drawing blocks until the SPI transfer is done
+#endif
+
+  // Sensor-to-pixel latency: from the most recent sensor read to the end of the SPI traffic
+  lastLatencyMicros = micros() - frame.sampleMicros;
+  if (lastLatencyMicros > maxLatencyMicros) maxLatencyMicros = lastLatencyMicros;
+  latencySumMicros += lastLatencyMicros;
+  if (++latencyCount >= latencyWindow) {
+    avgLatencyMicros = latencySumMicros / latencyCount;
+    latencySumMicros = 0;
+    latencyCount = 0;
+  }
+  metrics.observe(STAT_LATENCY_MICROS, lastLatencyMicros);
+  metrics.observe(STAT_DISPLAY_MICROS, displayMicros);
+  metrics.set(STAT_FRAMES_RENDERED, frameGovernor.framesRendered());
+  metrics.set(STAT_FRAMES_SKIPPED, frameGovernor.framesSkipped());
+  metrics.set(STAT_UPDATES_COALESCED, frameGovernor.updatesCoalesced());
+  metrics.set(STAT_LOG_DROPPED, logBuffer.droppedRecords());
+
+  tuningConsole.noteFrame(frame.modelVersion, frame.inferenceMicros);
+
+  // Boot report, once, with the first frame on valid inputs
+  static bool bootReported = false;
+  if (!bootReported && frame.inputsValid) {
+    bootReported = true;
+    char text[80];
+    char* p = appendText("Boot: first pump decision at ", text);
+    p = formatUnsigned(metrics.value(STAT_BOOT_DECISION_MILLIS), p);
+    p = appendText("ms (display ready at ", p);
+    p = formatUnsigned(displayReadyMillis, p);
+    appendText("ms)", p);
+    logBuffer.writeLine(text);
+  }
 
-  // --- Task 3: Process Fuzzy Logic and Update Display ---
-  if (currentTime - lastLogicDisplayTime >= logicDisplayInterval) {
-    lastLogicDisplayTime = currentTime;
-
-    // Check if all sensor data is valid before using
-    if (!isnan(currentTemperature) && !isnan(currentHumidity) && !isnan(currentSoilMoisture)) {
-      fuzzy->setInput(1, currentTemperature);
-      fuzzy->setInput(2, currentHumidity);
-      fuzzy->setInput(3, currentSoilMoisture);
-      
-      fuzzy->fuzzify();
-      currentPumpPower = fuzzy->defuzzify(1);
-
-      // Serial Printing for Debugging
-      Serial.print("Temp: "); Serial.print(currentTemperature, 1); Serial.print("°C, ");
-      Serial.print("Humid: "); Serial.print(currentHumidity, 1); Serial.print("%, ");
-      Serial.print("Soil: "); Serial.print(currentSoilMoisture, 1); Serial.print("%, ");
-      Serial.print("Pump: "); Serial.print(currentPumpPower, 1); Serial.println("%");
-
-      // Update the display with the latest processed values
-      myDisplay.updateValues(currentTemperature, currentHumidity, currentSoilMoisture, currentPumpPower);
-    } else {
-      // Handle cases where sensor data might still be NAN (e.g., initial readings)
-      // The display library should already handle NANs by printing "---"
-      myDisplay.updateValues(currentTemperature, currentHumidity, currentSoilMoisture, currentPumpPower);
-      Serial.println("Waiting for all sensor data to be valid...");
+#if FUZZY_FLASH_LOG
+  pollFlashLog(frame);
+#endif
+
+#if FUZZY_TELEMETRY
+  // One binary record per frame, queued as one log record (decoded by host/telemetry_decode)
+  static uint16_t telemetrySequence = 0;
+  TelemetryRecord record;
+  telemetryFromFrame(frame, record);
+  record.sequence = telemetrySequence++;
+  record.timeMillis = millis();
+  record.latencyMicros = lastLatencyMicros;
+  uint8_t telemetryFrame[TELEMETRY_MAX_FRAME];
+  logBuffer.write(telemetryFrame, encodeTelemetry(record, telemetryFrame));
+#else
+  if (frame.inputsValid) {
+    // Serial Printing for Debugging: the line is composed with the fixed-point formatter
+    // (same text as print(value, 1)) and queued as one log record
+    char line[128];
+    char* p = appendText("Temp: ", line);
+    p = formatTenths(toTenths(frame.temperature), p);
+    p = appendText("°C, Humid: ", p);
+    p = formatTenths(toTenths(frame.humidity), p);
+    p = appendText("%, Soil: ", p);
+    p = formatTenths(toTenths(frame.soilMoisture), p);
+    p = appendText("%, Pump: ", p);
+    p = formatTenths(toTenths(frame.pumpPower), p);
+    p = appendText("%, Latency: ", p);
+    p = formatUnsigned(lastLatencyMicros, p);
+    p = appendText("us (avg ", p);
+    p = formatUnsigned(avgLatencyMicros, p);
+    p = appendText(", max ", p);
+    p = formatUnsigned(maxLatencyMicros, p);
+    appendText(")", p);
+    logBuffer.writeLine(line);
+  } else {
+    logBuffer.writeLine("Waiting for all sensor data to be valid...");
+  }
+#endif
+
+#if FUZZY_BENCHMARK
+  // Display traffic of this update (what the framebuffer actually pushed over SPI)
+  char line[128];
+  char* p = appendText("Display: ", line);
+  p = formatUnsigned(displayMicros, p);
+  p = appendText("us", p);
+#if FUZZY_FRAMEBUFFER
+  const FlushStats& stats = myDisplay.lastFlushStats();
+  p = appendText(", ", p);
+  p = formatUnsigned(stats.transactions, p);
+  p = appendText(" transactions, ", p);
+  p = formatUnsigned(stats.bytes, p);
+  p = appendText(" bytes, ", p);
+  p = formatUnsigned(stats.pixels, p);
+  p = appendText(" pixels", p);
+#endif
+  p = appendText(", frames ", p);
+  p = formatUnsigned(frameGovernor.framesRendered(), p);
+  p = appendText(" (skipped ", p);
+  p = formatUnsigned(frameGovernor.framesSkipped(), p);
+  p = appendText(", coalesced ", p);
+  p = formatUnsigned(frameGovernor.updatesCoalesced(), p);
+  p = appendText("), log dropped ", p);
+  formatUnsigned(logBuffer.droppedRecords(), p);
+  logBuffer.writeLine(line);
+#else
+  (void)displayMicros;
+#endif
+}
+
+#if FUZZY_FLASH_LOG
+// Appends the frame to the flash log once per flashLogInterval. Runs on the rendering side,
+// but an ESP32 flash write or erase turns the flash cache off on both cores: everything not
+// in IRAM stops on core 0 as well, so inference, the pump update and the DHT22 capture stall
+// for it too. A page write (every ~25 minutes) takes a few ms, a sector erase (every few
+// hours) typically 45 ms and up to about 400 ms. A DHT22 read during an erase may fail.
+// The pump's freshness bound (5 s, one missed DHT22 read) leaves room for both.
+void pollFlashLog(const ControlFrame& frame) {
+  unsigned long now = millis();
+  if (now - lastFlashLogTime < flashLogInterval) {
+    return;
+  }
+  lastFlashLogTime = now;
+  FlashLogRecord record;
+  record.boot = flashLog.bootNumber();
+  record.uptimeSeconds = now / 1000;
+  record.temperature = toTenths16(frame.temperature);
+  record.humidity = toTenths16(frame.humidity);
+  record.soilMoisture = toTenths16(frame.soilMoisture);
+  record.pumpPower = toTenths16(frame.pumpPower);
+  record.flags = frame.inputsValid ? FLASH_LOG_INPUTS_VALID : 0;
+  flashLog.append(record);
+}
+#endif
+
+// --- Task 5: Page Button ---
+// Each press switches the display to the next page. Runs where the display is drawn.
+void pollPageButton() {
+  bool pressed = digitalRead(PAGE_BUTTON_PIN) == LOW;
+  if (pressed != pageButtonPressed && millis() - lastPageButtonChange >= pageButtonDebounce) {
+    lastPageButtonChange = millis();
+    pageButtonPressed = pressed;
+    if (pressed) {
+      FuzzyDisplay::Page next = (FuzzyDisplay::Page)((myDisplay.currentPage() + 1) % FuzzyDisplay::PAGE_COUNT);
+      myDisplay.showPage(next);
     }
   }
+}
+
+// --- Task 6: Send Queued Log Records ---
+// Writes only what the UART TX buffer can take right now; the rest waits for the next call.
+void drainLog() {
+  logBuffer.drain(Serial);
+}
+
+// Charges one pass of loop() (or of a task) to the loop metrics
+void notePass(unsigned long startMicros) {
+  unsigned long passMicros = micros() - startMicros;
+  metrics.observe(STAT_LOOP_MICROS, passMicros);
+  if (passMicros > loopOverrunMicros) {
+    metrics.add(STAT_LOOP_OVERRUNS);
+  }
+}
+
+// --- Task 7: Tuning Console and Profile Selection ---
+// Commands from Serial (see TuningConsole.h), and profile changes from the jumpers and the
+// schedule. Runs where the display is drawn, so a changed set can go straight to the
+// membership page.
+void pollConsole() {
+  while (Serial.available() > 0) {
+    if (tuningConsole.feed((char)Serial.read())) {
+      showModelSets(tuningConsole.model());
+    }
+  }
+  uint8_t profile = profileSelector.poll(millis());
+  if (profile != ProfileSelector::NONE && tuningConsole.selectProfile(profile)) {
+    showModelSets(tuningConsole.model());
+  }
+  tuningConsole.poll();
+}
+
+#if FUZZY_DUAL_CORE
+// Core 0: sensor acquisition, fuzzy inference and the pump. Never touches SPI or Serial.
+void acquisitionTask(void* parameter) {
+  for (;;) {
+    unsigned long passStart = micros();
+#if FUZZY_COROUTINES
+    coExecutor.poll();
+#else
+    pollTasks(millis());
+#endif
+    pollPump();
+    notePass(passStart);
+    vTaskDelay(1); // Yield so the idle task (and its watchdog) can run on core 0
+  }
+}
+
+// Core 1: display rendering and serial logging of the latest frame.
+void renderTask(void* parameter) {
+  for (;;) {
+    // Sleep until the acquisition task publishes (waking briefly to check the page button
+    // and to retry a frame the governor deferred)
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+    unsigned long passStart = micros(); // The wait above is not work
+    pollRender(millis());
+    pollPageButton();
+    pollConsole();
+    drainLog();
+    notePass(passStart);
+  }
+}
+#endif
+
+void loop() {
+#if FUZZY_DUAL_CORE
+  // All work happens in acquisitionTask/renderTask; the Arduino loop task is not needed.
+  vTaskDelete(NULL);
+#else
+  unsigned long passStart = micros();
+#if FUZZY_COROUTINES
+  coExecutor.poll(); // Resumes whichever coroutines are ready; never blocks
+#else
+  pollTasks(millis()); // Get current time once per loop
+#endif
+  pollPump();
+  pollRender(millis());
+  pollPageButton();
+  pollConsole();
+  drainLog(); // Idle point of the loop: all time-critical work of this pass is done
+  notePass(passStart);
   
   //non-blocking tasks
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+// FuzzyModel.cpp
+#include "FuzzyModel.h" // Include the header file we just defined
+#include "FixedFormat.h"
+
+// Range each variable's sets must cover (same units as the readings)
+static const float VARIABLE_RANGES[MODEL_VARIABLES][2] = {
+  {-5, 45},  // Temperature, degrees C
+  {0, 100},  // Humidity, percent
+  {0, 100},  // Soil moisture, percent
+  {0, 100}   // Pump power, percent
+};
+
+static const char* const VARIABLE_NAMES[MODEL_VARIABLES] = {"temp", "humid", "soil", "pump"};
+
+static const char* const SET_NAMES[MODEL_VARIABLES][MODEL_OUTPUT_SETS] = {
+  {"low", "medium", "high", NULL},
+  {"low", "medium", "high", NULL},
+  {"dry", "moist", "wet", NULL},
+  {"none", "low", "moderate", "full"}
+};
+
+// modelSetCount function implementation
+uint8_t modelSetCount(uint8_t variable) {
+  return variable == MODEL_OUTPUT ? MODEL_OUTPUT_SETS : MODEL_LEVELS;
+}
+
+// modelSet function implementation
+SetPoints& modelSet(FuzzyModel& model, uint8_t variable, uint8_t level) {
+  return variable == MODEL_OUTPUT ? model.outputSets[level] : model.inputSets[variable][level];
+}
+
+// modelSet function implementation
+const SetPoints& modelSet(const FuzzyModel& model, uint8_t variable, uint8_t level) {
+  return variable == MODEL_OUTPUT ? model.outputSets[level] : model.inputSets[variable][level];
+}
+
+// modelVariableRange function implementation
+void modelVariableRange(uint8_t variable, float& low, float& high) {
+  low = VARIABLE_RANGES[variable][0];
+  high = VARIABLE_RANGES[variable][1];
+}
+
+// modelVariableName function implementation
+const char* modelVariableName(uint8_t variable) {
+  return variable < MODEL_VARIABLES ? VARIABLE_NAMES[variable] : "?";
+}
+
+// modelSetName function implementation
+const char* modelSetName(uint8_t variable, uint8_t level) {
+  if (variable >= MODEL_VARIABLES || level >= modelSetCount(variable)) {
+    return "?";
+  }
+  return SET_NAMES[variable][level];
+}
+
+// parseModelLevel function implementation
+bool parseModelLevel(uint8_t variable, const char* name, uint8_t& level) {
+  for (uint8_t i = 0; i < modelSetCount(variable); i++) {
+    if (strcmp(name, SET_NAMES[variable][i]) == 0) {
+      level = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// parseModelSet function implementation
+bool parseModelSet(const char* text, uint8_t& variable, uint8_t& level) {
+  const char* dot = strchr(text, '.');
+  if (dot == NULL) {
+    return false;
+  }
+  size_t length = dot - text;
+  for (uint8_t v = 0; v < MODEL_VARIABLES; v++) {
+    if (strlen(VARIABLE_NAMES[v]) == length && strncmp(text, VARIABLE_NAMES[v], length) == 0) {
+      variable = v;
+      return parseModelLevel(v, dot + 1, level);
+    }
+  }
+  return false;
+}
+
+// Writes "<subject>: <problem>" to error
+static bool fail(char* error, const char* subject, const char* problem) {
+  char* p = appendText(subject, error);
+  p = appendText(": ", p);
+  appendText(problem, p);
+  return false;
+}
+
+// Writes "<variable>.<set>: <problem>" to error
+static bool failSet(char* error, uint8_t variable, uint8_t level, const char* problem) {
+  char name[20];
+  char* p = appendText(modelVariableName(variable), name);
+  p = appendText(".", p);
+  appendText(modelSetName(variable, level), p);
+  return fail(error, name, problem);
+}
+
+// validateModel function implementation
+bool validateModel(const FuzzyModel& model, char* error) {
+  for (uint8_t variable = 0; variable < MODEL_VARIABLES; variable++) {
+    const float low = VARIABLE_RANGES[variable][0];
+    const float high = VARIABLE_RANGES[variable][1];
+    const uint8_t count = modelSetCount(variable);
+    for (uint8_t level = 0; level < count; level++) {
+      const SetPoints& set = modelSet(model, variable, level);
+      if (!(set.a <= set.b && set.b <= set.c && set.c <= set.d && set.a < set.d)) {
+        return failSet(error, variable, level, "points must be a <= b <= c <= d, a < d");
+      }
+      if (set.a < low || set.d > high) {
+        return failSet(error, variable, level, "points outside the variable's range");
+      }
+      if (level > 0) {
+        const SetPoints& previous = modelSet(model, variable, level - 1);
+        if (set.b < previous.b) {
+          return failSet(error, variable, level, "out of order with the set below");
+        }
+        if (set.a >= previous.d) {
+          return failSet(error, variable, level, "gap to the set below");
+        }
+      }
+    }
+    if (modelSet(model, variable, 0).b != low) {
+      return failSet(error, variable, 0, "must be 1 at the range start (b)");
+    }
+    if (modelSet(model, variable, count - 1).c != high) {
+      return failSet(error, variable, count - 1, "must be 1 at the range end (c)");
+    }
+  }
+
+  if (model.ruleCount == 0 || model.ruleCount > MODEL_MAX_RULES) {
+    return fail(error, "rules", "count out of range");
+  }
+  for (uint8_t r = 0; r < model.ruleCount; r++) {
+    const RuleMapping& rule = model.rules[r];
+    char name[12];
+    formatUnsigned(r + 1, appendText("rule ", name));
+    uint8_t tested = 0;
+    for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+      if (rule.inputs[input] == RULE_ANY) continue;
+      if (rule.inputs[input] >= MODEL_LEVELS) {
+        return fail(error, name, "unknown input set");
+      }
+      tested++;
+    }
+    if (tested == 0) {
+      return fail(error, name, "needs at least one input set");
+    }
+    if (rule.output >= MODEL_OUTPUT_SETS) {
+      return fail(error, name, "unknown output set");
+    }
+  }
+  return true;
+}
@@ -0,0 +1,79 @@
+// FuzzyModel.h
+#ifndef FuzzyModel_h // Include guard to prevent multiple inclusions
+#define FuzzyModel_h
+
+#include <Arduino.h>
+#include "ControlFrame.h"
+
+// The controller as plain data: the trapezoid of every set and every rule's mapping.
+// Inference (FuzzyEngine.h) reads it in place, so a model is never built out of objects:
+// it can be a constant in flash, a stored blob (ModelBlob.h) or a copy being edited on the
+// console, and is printed, checked and handed between tasks as it is.
+
+const uint8_t MODEL_INPUTS = MEMBERSHIP_INPUTS; // Temperature, humidity, soil moisture
+const uint8_t MODEL_LEVELS = RULE_GRID_LEVELS;  // Sets per input, low to high
+const uint8_t MODEL_OUTPUT_SETS = 4;            // Pump power sets, none to full
+const uint8_t MODEL_MAX_RULES = 24;
+const uint8_t RULE_ANY = 0xFF;                  // Rule doesn't test this input
+
+// Variables: the inputs in ControlFrame order, then the pump power output
+const uint8_t MODEL_OUTPUT = MODEL_INPUTS;
+const uint8_t MODEL_VARIABLES = MODEL_INPUTS + 1;
+
+// Set levels, for writing rules: temperature and humidity, soil moisture, pump power
+enum InputLevel { SET_LOW, SET_MEDIUM, SET_HIGH };
+enum SoilLevel { SET_DRY, SET_MOIST, SET_WET };
+enum WaterLevel { WATER_NONE, WATER_LOW, WATER_MODERATE, WATER_FULL };
+
+// Trapezoid: membership 0 up to a, rising to 1 at b, 1 up to c, falling to 0 at d
+struct SetPoints {
+  float a;
+  float b;
+  float c;
+  float d;
+};
+
+// IF every tested input is in its set THEN the pump power is in the output set
+struct RuleMapping {
+  uint8_t inputs[MODEL_INPUTS]; // Set level per input, RULE_ANY if not tested
+  uint8_t output;               // Output set level
+};
+
+struct FuzzyModel {
+  SetPoints inputSets[MODEL_INPUTS][MODEL_LEVELS];
+  SetPoints outputSets[MODEL_OUTPUT_SETS];
+  RuleMapping rules[MODEL_MAX_RULES];
+  uint8_t ruleCount;
+};
+
+// Longest message validateModel() writes, with its terminator
+const uint8_t MODEL_ERROR_LENGTH = 64;
+
+// Number of sets of a variable, and the set's points
+uint8_t modelSetCount(uint8_t variable);
+SetPoints& modelSet(FuzzyModel& model, uint8_t variable, uint8_t level);
+const SetPoints& modelSet(const FuzzyModel& model, uint8_t variable, uint8_t level);
+
+// Range a variable's sets cover (same units as the readings): temperature -5 to 45 C,
+// the others 0 to 100 percent
+void modelVariableRange(uint8_t variable, float& low, float& high);
+
+// Names used on the console: "temp", "humid", "soil", "pump" and the set names of each
+// ("low", "dry", "full", ...), written together as "soil.dry"
+const char* modelVariableName(uint8_t variable);
+const char* modelSetName(uint8_t variable, uint8_t level);
+
+// Looks up a set level of a variable by name. False if there is no such set.
+bool parseModelLevel(uint8_t variable, const char* name, uint8_t& level);
+
+// Looks up "variable.set". False if either part is unknown.
+bool parseModelSet(const char* text, uint8_t& variable, uint8_t& level);
+
+// Checks that the model can be used: every set ordered (a <= b <= c <= d, a < d) and inside
+// its variable's range, the sets of a variable in order, overlapping their neighbours and
+// reaching full membership at both ends of the range (so every value belongs to some set),
+// and every rule testing at least one input with existing set levels. Returns true if it
+// can; otherwise writes what is wrong to error (MODEL_ERROR_LENGTH bytes).
+bool validateModel(const FuzzyModel& model, char* error);
+
+#endif // End of include guard
@@ -0,0 +1,59 @@
+// HistoryBuffer.cpp
+#include "HistoryBuffer.h" // Include the header file we just defined
+
+// Constructor implementation
+HistoryBuffer::HistoryBuffer(unsigned long columnMillis) :
+  head(0),
+  stored(0),
+  totalStored(0),
+  columnMillis(columnMillis),
+  columnStart(0),
+  started(false),
+  soilSum(0),
+  pumpSum(0),
+  soilCount(0),
+  pumpCount(0) {
+}
+
+// average method implementation: whole-percent average, or NO_DATA for an empty period
+uint8_t HistoryBuffer::average(float sum, uint16_t n) {
+  if (n == 0) {
+    return NO_DATA;
+  }
+  return (uint8_t)constrain(lround(sum / n), 0L, 100L);
+}
+
+// add method implementation
+bool HistoryBuffer::add(float soil, float pump, unsigned long nowMillis) {
+  if (!started) {
+    columnStart = nowMillis;
+    started = true;
+  }
+  if (!isnan(soil)) { soilSum += soil; soilCount++; }
+  if (!isnan(pump)) { pumpSum += pump; pumpCount++; }
+
+  if (nowMillis - columnStart < columnMillis) {
+    return false;
+  }
+
+  // Column period over: store the averages and start the next period
+  samples[head].soil = average(soilSum, soilCount);
+  samples[head].pump = average(pumpSum, pumpCount);
+  head = (head + 1) % CAPACITY;
+  if (stored < CAPACITY) stored++;
+  totalStored++;
+
+  columnStart += columnMillis;
+  if (nowMillis - columnStart >= columnMillis) {
+    columnStart = nowMillis; // Fell behind by more than a column (e.g. long stall): resync
+  }
+  soilSum = pumpSum = 0;
+  soilCount = pumpCount = 0;
+  return true;
+}
+
+// at method implementation
+HistorySample HistoryBuffer::at(uint8_t i) const {
+  uint8_t oldest = (head + CAPACITY - stored) % CAPACITY;
+  return samples[(oldest + i) % CAPACITY];
+}
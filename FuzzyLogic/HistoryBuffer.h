@@ -0,0 +1,56 @@
+// HistoryBuffer.h
+#ifndef HistoryBuffer_h // Include guard to prevent multiple inclusions
+#define HistoryBuffer_h
+
+#include <Arduino.h>
+
+// One downsampled history point: averages over one column period, in whole percent.
+struct HistorySample {
+  uint8_t soil; // Average soil moisture (0-100), or HistoryBuffer::NO_DATA
+  uint8_t pump; // Average pump power (0-100), or HistoryBuffer::NO_DATA
+};
+
+// Compact ring buffer of soil moisture / pump power history for the trend chart.
+// add() is called with every reading; readings are averaged over columnMillis and
+// stored as one 2-byte HistorySample per column, so CAPACITY columns cover
+// CAPACITY * columnMillis of history (136 columns x 1 min = 2h16m by default).
+class HistoryBuffer {
+  public:
+    static const uint8_t CAPACITY = 136;  // One sample per chart column
+    static const uint8_t NO_DATA = 0xFF;  // Column period without a valid reading
+
+    // columnMillis: averaging period of one stored sample.
+    explicit HistoryBuffer(unsigned long columnMillis);
+
+    // Accumulates a reading (NAN values are ignored). Returns true when a column period
+    // has ended and a new sample was stored (see newest()).
+    bool add(float soil, float pump, unsigned long nowMillis);
+
+    // Number of stored samples (up to CAPACITY).
+    uint8_t count() const { return stored; }
+
+    // i-th stored sample, 0 = oldest.
+    HistorySample at(uint8_t i) const;
+
+    // Most recently stored sample.
+    HistorySample newest() const { return at(stored - 1); }
+
+    // Total number of samples ever stored (wraps at 2^32); used to place chart columns.
+    uint32_t total() const { return totalStored; }
+
+  private:
+    static uint8_t average(float sum, uint16_t n);
+
+    HistorySample samples[CAPACITY];
+    uint8_t head;          // Index where the next sample is written
+    uint8_t stored;        // Number of valid samples
+    uint32_t totalStored;
+
+    unsigned long columnMillis;
+    unsigned long columnStart; // millis() when the current column period began
+    bool started;
+    float soilSum, pumpSum;    // Sums of the current column period
+    uint16_t soilCount, pumpCount;
+};
+
+#endif // End of include guard
@@ -0,0 +1,115 @@
+// LogBuffer.cpp
+#include "LogBuffer.h" // Include the header file we just defined
+
+// Constructor implementation
+LogBuffer::LogBuffer(OverflowPolicy policy) :
+  policy(policy),
+  head(0),
+  tail(0),
+  dropped(0),
+  pendingLength(0),
+  pendingSent(0) {
+  for (uint8_t i = 0; i < SLOTS; i++) {
+    slots[i].sequence.store(0, std::memory_order_relaxed); // No record 0 written yet (expects 2)
+    slots[i].length = 0;
+  }
+}
+
+// write method implementation
+bool LogBuffer::write(const uint8_t* data, size_t length) {
+  if (length > SLOT_BYTES) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  uint32_t h = head.load(std::memory_order_relaxed);
+  if (policy == DROP_NEWEST && h - tail.load(std::memory_order_acquire) >= SLOTS) {
+    dropped.fetch_add(1, std::memory_order_relaxed); // Full: the queued records win
+    return false;
+  }
+
+  // With DROP_OLDEST this may be the slot of a record not sent yet: the odd sequence
+  // tells the consumer it is being replaced
+  Slot& slot = slots[h % SLOTS];
+  slot.sequence.store(2 * h + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.length = (uint8_t)length;
+  memcpy(slot.data, data, length);
+  slot.sequence.store(2 * h + 2, std::memory_order_release);
+  head.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+// writeLine method implementation
+bool LogBuffer::writeLine(const char* line) {
+  uint8_t record[SLOT_BYTES];
+  size_t length = strlen(line);
+  if (length + 2 > SLOT_BYTES) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  memcpy(record, line, length);
+  record[length++] = '\r';
+  record[length++] = '\n';
+  return write(record, length);
+}
+
+// queuedRecords method implementation
+uint32_t LogBuffer::queuedRecords() const {
+  uint32_t queued = head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed);
+  return min(queued, (uint32_t)SLOTS);
+}
+
+// takeRecord method implementation
+bool LogBuffer::takeRecord() {
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  for (;;) {
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (t == h) {
+      return false;
+    }
+    if (h - t > SLOTS) {
+      // The producer has lapped us (DROP_OLDEST): the oldest records are gone
+      dropped.fetch_add((h - SLOTS) - t, std::memory_order_relaxed);
+      t = h - SLOTS;
+    }
+
+    // Copy, then check that the slot still holds the same complete record (Seqlock-style)
+    Slot& slot = slots[t % SLOTS];
+    uint32_t expected = 2 * t + 2;
+    if (slot.sequence.load(std::memory_order_acquire) == expected) {
+      uint8_t length = slot.length;
+      if (length <= SLOT_BYTES) {
+        memcpy(pending, slot.data, length);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == expected && length <= SLOT_BYTES) {
+        pendingLength = length;
+        pendingSent = 0;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+      }
+    }
+    // Replaced by a newer record before or while it was copied
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    t++;
+    tail.store(t, std::memory_order_release);
+  }
+}
+
+// drain method implementation
+size_t LogBuffer::drain(Print& out) {
+  size_t written = 0;
+  for (;;) {
+    if (pendingSent == pendingLength && !takeRecord()) {
+      break; // Everything sent
+    }
+    int room = out.availableForWrite();
+    if (room <= 0) {
+      break; // Output buffer full: continue on the next call instead of waiting
+    }
+    size_t chunk = min((size_t)room, (size_t)(pendingLength - pendingSent));
+    written += out.write(pending + pendingSent, chunk);
+    pendingSent += chunk;
+  }
+  return written;
+}
@@ -0,0 +1,75 @@
+// LogBuffer.h
+#ifndef LogBuffer_h // Include guard to prevent multiple inclusions
+#define LogBuffer_h
+
+#include <Arduino.h>
+#include <atomic>
+
+// Non-blocking log output: records (text lines or telemetry frames) are queued in a
+// lock-free ring of fixed-size slots and sent to Serial later, from an idle point of the
+// loop or the render task.
+//
+// write() never waits: if the ring is full, either the new record is dropped
+// (DROP_NEWEST) or it replaces the oldest one still queued (DROP_OLDEST). Every lost
+// record is counted. drain() only writes as many bytes as the output can take without
+// blocking (Print::availableForWrite()), so neither side ever stalls inference or the
+// display on a full UART.
+//
+// One producer context and one consumer context (which may be on different cores).
+// With DROP_OLDEST the producer may overwrite a slot the consumer is copying; each slot
+// has a sequence number (written odd/even like Seqlock), so the consumer notices and
+// counts that record as dropped instead of sending a torn one.
+class LogBuffer {
+  public:
+    // What write() does when all slots are taken.
+    enum OverflowPolicy {
+      DROP_NEWEST, // Keep the queued records, drop the new one
+      DROP_OLDEST  // Overwrite the oldest queued record with the new one
+    };
+
+    static const uint8_t SLOTS = 16;        // Queued records (power of two)
+    static const uint8_t SLOT_BYTES = 128;  // Longest record
+
+    explicit LogBuffer(OverflowPolicy policy);
+
+    // Producer: queues a record. Returns false if it was dropped (ring full with
+    // DROP_NEWEST, or longer than SLOT_BYTES).
+    bool write(const uint8_t* data, size_t length);
+
+    // Producer: queues a text line, followed by "\r\n" like println().
+    bool writeLine(const char* line);
+
+    // Consumer: sends queued bytes to out, at most out.availableForWrite() of them.
+    // Returns the number of bytes written.
+    size_t drain(Print& out);
+
+    // Records queued and not yet taken by drain() (at most SLOTS). Lets a producer with
+    // many lines to write pace itself instead of overwriting records.
+    uint32_t queuedRecords() const;
+
+    // Records lost so far (dropped by write() or overwritten before they were sent).
+    uint32_t droppedRecords() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    struct Slot {
+      std::atomic<uint32_t> sequence; // 2 * record number + 1 while written, + 2 when complete
+      uint8_t length;
+      uint8_t data[SLOT_BYTES];
+    };
+
+    // Consumer: copies the next complete record into pending. False if none is queued.
+    bool takeRecord();
+
+    OverflowPolicy policy;
+    Slot slots[SLOTS];
+    std::atomic<uint32_t> head;    // Records ever written (producer)
+    std::atomic<uint32_t> tail;    // Records ever taken or skipped (consumer)
+    std::atomic<uint32_t> dropped;
+
+    // Consumer side: record being sent, possibly over several drain() calls
+    uint8_t pending[SLOT_BYTES];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+};
+
+#endif // End of include guard
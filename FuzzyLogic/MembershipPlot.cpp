@@ -0,0 +1,102 @@
+// MembershipPlot.cpp
+#include "MembershipPlot.h" // Include the header file we just defined
+
+// Curve color of each set, indexed by set
+static const uint16_t SET_COLORS[MembershipPlot::SETS] = {
+  MembershipPlot::LOW_COLOR, MembershipPlot::MEDIUM_COLOR, MembershipPlot::HIGH_COLOR
+};
+
+// Constructor implementation
+MembershipPlot::MembershipPlot() :
+  rangeMin(0),
+  rangeMax(0) {
+  for (uint8_t set = 0; set < SETS; set++) {
+    defined[set] = false;
+  }
+}
+
+// setSet method implementation
+void MembershipPlot::setSet(uint8_t set, float a, float b, float c, float d) {
+  if (set >= SETS) {
+    return;
+  }
+  points[set][0] = a;
+  points[set][1] = b;
+  points[set][2] = c;
+  points[set][3] = d;
+  defined[set] = true;
+  rebuild();
+}
+
+// column method implementation
+int16_t MembershipPlot::column(float value) const {
+  if (isnan(value) || rangeMax <= rangeMin) {
+    return -1;
+  }
+  long x = lround((value - rangeMin) * (WIDTH - 1) / (rangeMax - rangeMin));
+  return (int16_t)constrain(x, 0L, (long)(WIDTH - 1));
+}
+
+// degree method implementation
+float MembershipPlot::degree(uint8_t set, float value) const {
+  const float* p = points[set];
+  if (value < p[0] || value > p[3]) {
+    return 0;
+  }
+  if (value < p[1]) {
+    return (value - p[0]) / (p[1] - p[0]); // Rising edge (b > a here)
+  }
+  if (value <= p[2]) {
+    return 1;
+  }
+  return (p[3] - value) / (p[3] - p[2]);   // Falling edge (d > c here)
+}
+
+// rebuild method implementation
+void MembershipPlot::rebuild() {
+  bool first = true;
+  for (uint8_t set = 0; set < SETS; set++) {
+    if (!defined[set]) continue;
+    if (first || points[set][0] < rangeMin) rangeMin = points[set][0];
+    if (first || points[set][3] > rangeMax) rangeMax = points[set][3];
+    first = false;
+  }
+
+  for (uint8_t set = 0; set < SETS; set++) {
+    if (!defined[set]) continue;
+    int16_t previous = -1;
+    for (int16_t x = 0; x < WIDTH; x++) {
+      float value = rangeMin + (rangeMax - rangeMin) * x / (WIDTH - 1);
+      int16_t y = (HEIGHT - 1) - (int16_t)lround(degree(set, value) * (HEIGHT - 1));
+      CurveSpan& span = spans[set][x];
+      span.top = span.bottom = y;
+      // Fill the rows between this point and the previous one (on this column's side)
+      if (previous >= 0 && previous < y - 1) span.top = previous + 1;
+      if (previous > y + 1) span.bottom = previous - 1;
+      previous = y;
+    }
+  }
+}
+
+// renderColumn method implementation
+void MembershipPlot::renderColumn(int16_t x, bool marker, uint16_t* pixels) const {
+  uint16_t background = marker ? MARKER_COLOR : 0x0000;
+  for (int16_t y = 0; y < HEIGHT; y++) {
+    pixels[y] = background;
+  }
+  if (!marker) {
+    // Axis at membership 0, dotted line at membership 1
+    pixels[HEIGHT - 1] = GRID_COLOR;
+    if (x % 4 == 0) pixels[0] = GRID_COLOR;
+  }
+  if (x < 0 || x >= WIDTH) {
+    return;
+  }
+  for (uint8_t set = 0; set < SETS; set++) {
+    if (!defined[set]) continue;
+    const CurveSpan& span = spans[set][x];
+    for (int16_t y = span.top; y <= span.bottom; y++) {
+      pixels[y] = SET_COLORS[set]; // Later (higher) sets are drawn over earlier ones
+    }
+  }
+}
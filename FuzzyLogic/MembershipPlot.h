@@ -0,0 +1,60 @@
+// MembershipPlot.h
+#ifndef MembershipPlot_h // Include guard to prevent multiple inclusions
+#define MembershipPlot_h
+
+#include <Arduino.h>
+
+// Membership function plot of one fuzzy input for the membership page.
+//
+// The trapezoids of the input's sets are rasterized once, when they are set, into a
+// cached background: for every plot column, the rows each curve covers there. Any
+// column of the plot can then be rendered from the cache with integer work only, so the
+// page draws the curves once and afterwards moves the input marker by restoring the
+// column it leaves and rendering the column it enters (two 1 x HEIGHT transfers).
+class MembershipPlot {
+  public:
+    static const uint8_t SETS = 3;      // Sets per input, ordered low to high
+    static const int16_t WIDTH = 144;   // Plot columns (input range from left to right)
+    static const int16_t HEIGHT = 22;   // Plot rows (membership 1 at the top, 0 at the bottom)
+
+    // Curve and label color of each set (low, medium, high)
+    static const uint16_t LOW_COLOR = 0x867F;    // Light blue
+    static const uint16_t MEDIUM_COLOR = 0x07E0; // Green
+    static const uint16_t HIGH_COLOR = 0xFC00;   // Orange
+    static const uint16_t GRID_COLOR = 0x4208;   // Dark gray
+    static const uint16_t MARKER_COLOR = 0xFFFF; // White
+
+    MembershipPlot();
+
+    // Sets the trapezoid (a, b, c, d) of a set, as in the model's SetPoints, and rebuilds
+    // the cached background. The plot spans from the smallest a to the largest d.
+    void setSet(uint8_t set, float a, float b, float c, float d);
+
+    // Plot column of an input value (clamped to the plot), or -1 for NAN or before any
+    // set was given.
+    int16_t column(float value) const;
+
+    // Renders one HEIGHT-pixel plot column from the cache, with the input marker on it
+    // if marker is true.
+    void renderColumn(int16_t x, bool marker, uint16_t* pixels) const;
+
+  private:
+    // Rows a curve covers in one column, joined to the previous column so steep edges
+    // stay continuous.
+    struct CurveSpan {
+      uint8_t top, bottom;
+    };
+
+    // Membership degree (0-1) of value in a set, as setMembership() (FuzzyEngine.h) computes it.
+    float degree(uint8_t set, float value) const;
+
+    // Rasterizes every defined set into spans.
+    void rebuild();
+
+    float points[SETS][4];   // Trapezoid of each set
+    bool defined[SETS];      // Set has been given
+    float rangeMin, rangeMax;
+    CurveSpan spans[SETS][WIDTH]; // The cached background
+};
+
+#endif // End of include guard
@@ -0,0 +1,124 @@
+// Metrics.cpp
+#include "Metrics.h" // Include the header file we just defined
+#include "FixedFormat.h"
+
+static const uint8_t NO_HISTOGRAM = 0xFF;
+
+static const char* const TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+
+// Constructor implementation
+MetricsRegistry::MetricsRegistry(const MetricDefinition* definitions, uint8_t count) :
+  definitions(definitions),
+  count(count < MAX_METRICS ? count : MAX_METRICS) { // Not min(): it takes MAX_METRICS by reference
+  uint8_t histogramCount = 0;
+  for (uint8_t i = 0; i < MAX_METRICS; i++) {
+    values[i].store(0, std::memory_order_relaxed);
+    histogramOf[i] = NO_HISTOGRAM;
+    if (i < this->count && definitions[i].type == METRIC_HISTOGRAM && histogramCount < MAX_HISTOGRAMS) {
+      histogramOf[i] = histogramCount++;
+    }
+  }
+  for (uint8_t h = 0; h < MAX_HISTOGRAMS; h++) {
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+      histograms[h].buckets[b].store(0, std::memory_order_relaxed);
+    }
+    histograms[h].sum.store(0, std::memory_order_relaxed);
+  }
+}
+
+// bucketOf method implementation
+uint8_t MetricsRegistry::bucketOf(uint32_t value) {
+  if (value <= 1) {
+    return 0;
+  }
+  uint8_t bits = 32 - __builtin_clz(value - 1); // Smallest i with value <= 2^i
+  return bits < BUCKETS - 1 ? bits : BUCKETS - 1;
+}
+
+// observe method implementation
+void MetricsRegistry::observe(uint8_t metric, uint32_t value) {
+  if (metric >= count || histogramOf[metric] == NO_HISTOGRAM) {
+    return;
+  }
+  Histogram& histogram = histograms[histogramOf[metric]];
+  histogram.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+  histogram.sum.fetch_add(value, std::memory_order_relaxed);
+  values[metric].fetch_add(1, std::memory_order_relaxed);
+}
+
+// value method implementation
+uint32_t MetricsRegistry::value(uint8_t metric) const {
+  return metric < count ? values[metric].load(std::memory_order_relaxed) : 0;
+}
+
+// formatLine method implementation
+bool MetricsRegistry::formatLine(DumpCursor& cursor, char* text) const {
+  // Histograms without a slot (more than MAX_HISTOGRAMS) are left out
+  while (cursor.metric < count && definitions[cursor.metric].type == METRIC_HISTOGRAM &&
+         histogramOf[cursor.metric] == NO_HISTOGRAM) {
+    cursor.metric++;
+  }
+  if (cursor.metric >= count) {
+    return false;
+  }
+  const MetricDefinition& definition = definitions[cursor.metric];
+  const uint8_t line = cursor.line++;
+  char* p = text;
+
+  if (line == 0) {
+    p = appendText("# HELP ", p);
+    p = appendText(definition.name, p);
+    p = appendText(" ", p);
+    appendText(definition.help, p);
+    return true;
+  }
+  if (line == 1) {
+    p = appendText("# TYPE ", p);
+    p = appendText(definition.name, p);
+    p = appendText(" ", p);
+    appendText(TYPE_NAMES[definition.type], p);
+    return true;
+  }
+
+  uint32_t value = values[cursor.metric].load(std::memory_order_relaxed);
+  p = appendText(definition.name, p);
+  if (definition.type != METRIC_HISTOGRAM) {
+    p = appendText(" ", p);
+    if (definition.type == METRIC_GAUGE) {
+      formatInteger((int32_t)value, p);
+    } else {
+      formatUnsigned(value, p);
+    }
+    cursor.metric++;
+    cursor.line = 0;
+    return true;
+  }
+
+  // Histogram: cumulative buckets up to the highest one in use, then +Inf, sum and count
+  const Histogram& histogram = histograms[histogramOf[cursor.metric]];
+  uint8_t top = 0;
+  for (uint8_t b = 0; b < BUCKETS - 1; b++) {
+    if (histogram.buckets[b].load(std::memory_order_relaxed) != 0) top = b;
+  }
+  uint8_t index = line - 2;
+  if (index <= top + 1) {
+    uint8_t last = index <= top ? index : BUCKETS - 1;
+    uint32_t cumulative = 0;
+    for (uint8_t b = 0; b <= last; b++) {
+      cumulative += histogram.buckets[b].load(std::memory_order_relaxed);
+    }
+    p = appendText("_bucket{le=\"", p);
+    p = index <= top ? formatUnsigned((uint32_t)1 << index, p) : appendText("+Inf", p);
+    p = appendText("\"} ", p);
+    formatUnsigned(cumulative, p);
+  } else if (index == top + 2) {
+    p = appendText("_sum ", p);
+    formatUnsigned(histogram.sum.load(std::memory_order_relaxed), p);
+  } else {
+    p = appendText("_count ", p);
+    formatUnsigned(value, p);
+    cursor.metric++;
+    cursor.line = 0;
+  }
+  return true;
+}
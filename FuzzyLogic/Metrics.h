@@ -0,0 +1,90 @@
+// Metrics.h
+#ifndef Metrics_h // Include guard to prevent multiple inclusions
+#define Metrics_h
+
+#include <Arduino.h>
+#include <atomic>
+
+// Kinds of metric, as in the Prometheus text format
+enum MetricType {
+  METRIC_COUNTER,  // Only goes up (events so far)
+  METRIC_GAUGE,    // Current value, may go up and down
+  METRIC_HISTOGRAM // Distribution of observed values (durations in microseconds)
+};
+
+// One entry of the sketch's metric table: the index in the table is the metric's id
+struct MetricDefinition {
+  const char* name; // Prometheus name, e.g. "fuzzy_inferences_total"
+  const char* help; // One line of description
+  MetricType type;
+};
+
+// Fixed-size registry of counters, gauges and histograms.
+//
+// The metrics are a const table (MetricDefinition) indexed by an enum in the sketch, like
+// the display's widget tables, so nothing is registered or allocated at runtime and an
+// update is one array access plus one relaxed atomic operation: safe and wait-free from
+// any task on either core. Interrupt handlers may update too.
+//
+// Histograms count values in power-of-two buckets (<= 1, <= 2, <= 4, ... <= 2^22, then
+// +Inf), so observe() is a bit count instead of a search, and 24 buckets cover 1 us to
+// over 4 s with at most a factor of two error. Their sum is 32 bits and wraps (after
+// about 71 minutes of summed microseconds); use the bucket counts for long runs.
+//
+// formatLine() writes the registry as Prometheus-style text one line at a time, so a
+// caller can send it at its own pace (TuningConsole's "metrics" command). Values are read
+// individually while the hot path keeps updating, so a dump is not one atomic snapshot.
+class MetricsRegistry {
+  public:
+    static const uint8_t MAX_METRICS = 20;
+    static const uint8_t MAX_HISTOGRAMS = 5;
+    static const uint8_t BUCKETS = 24;       // 23 bounded buckets (<= 2^0 .. 2^22), then +Inf
+    static const uint8_t LINE_LENGTH = 120;  // Longest line formatLine() writes, without the terminator
+
+    // Table entries beyond MAX_METRICS, and histograms beyond MAX_HISTOGRAMS, are ignored.
+    MetricsRegistry(const MetricDefinition* definitions, uint8_t count);
+
+    // Counter (or gauge): adds amount.
+    void add(uint8_t metric, uint32_t amount = 1) {
+      if (metric < count) values[metric].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Gauge (or a counter mirrored from elsewhere): sets the value.
+    void set(uint8_t metric, int32_t value) {
+      if (metric < count) values[metric].store((uint32_t)value, std::memory_order_relaxed);
+    }
+
+    // Histogram: counts one value.
+    void observe(uint8_t metric, uint32_t value);
+
+    // Current value of a counter or gauge, count of a histogram.
+    uint32_t value(uint8_t metric) const;
+
+    // Position in a dump: start with a default-constructed one.
+    struct DumpCursor {
+      uint8_t metric;
+      uint8_t line;
+      DumpCursor() : metric(0), line(0) {}
+    };
+
+    // Writes the next line of the dump to text (LINE_LENGTH + 1 bytes) and advances the
+    // cursor. False when the dump is complete.
+    bool formatLine(DumpCursor& cursor, char* text) const;
+
+  private:
+    // Bucket of a value: 0 for <= 1, i for 2^(i-1) < value <= 2^i, BUCKETS - 1 above 2^22.
+    static uint8_t bucketOf(uint32_t value);
+
+    struct Histogram {
+      std::atomic<uint32_t> buckets[BUCKETS];
+      std::atomic<uint32_t> sum;
+    };
+
+    const MetricDefinition* definitions;
+    uint8_t count;
+    std::atomic<uint32_t> values[MAX_METRICS]; // Counter/gauge value, histogram count
+    uint8_t histogramOf[MAX_METRICS];          // Histogram slot of each histogram metric
+    Histogram histograms[MAX_HISTOGRAMS];
+};
+
+#endif // End of include guard
@@ -0,0 +1,47 @@
+// ModelBlob.cpp
+#include "ModelBlob.h" // Include the header file we just defined
+#include "Checksum.h"
+#include <stddef.h>
+
+// buildModelBlob function implementation
+void buildModelBlob(const FuzzyModel& model, bool withTable, ModelBlob& blob) {
+  memset(&blob, 0, sizeof(blob));
+  blob.magic = MODEL_BLOB_MAGIC;
+  blob.version = MODEL_BLOB_VERSION;
+  blob.flags = withTable ? MODEL_BLOB_HAS_OUTPUT_TABLE : 0;
+  blob.size = sizeof(ModelBlob);
+  memcpy(&blob.model, &model, sizeof(model)); // A struct assignment may leave the padding undefined
+  if (withTable) {
+    fillOutputTable(blob.model, blob.outputTable);
+  }
+  blob.checksum = crc16Ccitt((const uint8_t*)&blob, offsetof(ModelBlob, checksum));
+}
+
+// mapModelBlob function implementation
+const ModelBlob* mapModelBlob(const void* data, size_t size) {
+  if (data == NULL || size < sizeof(ModelBlob)) {
+    return NULL;
+  }
+  const ModelBlob* blob = (const ModelBlob*)data;
+  if (blob->magic != MODEL_BLOB_MAGIC || blob->version != MODEL_BLOB_VERSION || blob->size != sizeof(ModelBlob)) {
+    return NULL; // Erased flash, another format or another build's layout
+  }
+  if (crc16Ccitt((const uint8_t*)blob, offsetof(ModelBlob, checksum)) != blob->checksum) {
+    return NULL; // Torn write
+  }
+  char error[MODEL_ERROR_LENGTH];
+  return validateModel(blob->model, error) ? blob : NULL;
+}
+
+// storeModelBlob function implementation
+bool storeModelBlob(FlashStore& store, const ModelBlob& blob) {
+  if (store.size() < sizeof(ModelBlob)) {
+    return false;
+  }
+  for (uint32_t address = 0; address < sizeof(ModelBlob); address += store.sectorSize()) {
+    if (!store.eraseSector(address)) {
+      return false;
+    }
+  }
+  return store.write(0, &blob, sizeof(blob));
+}
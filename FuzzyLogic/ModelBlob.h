@@ -0,0 +1,58 @@
+// ModelBlob.h
+#ifndef ModelBlob_h // Include guard to prevent multiple inclusions
+#define ModelBlob_h
+
+#include <Arduino.h>
+#include "FuzzyModel.h"
+#include "FuzzyEngine.h"
+#include "FlashStore.h"
+
+// A model as one flat, position-independent record: a header, the FuzzyModel (sets and
+// rules), the optional sampled output table (FuzzyEngine.h) and a CRC-16 over everything
+// before it. It contains no pointers, so the same bytes work as a constant compiled into
+// flash, in a RAM buffer, or mapped from a flash partition, and inference reads it where
+// it is: booting with a model costs a header check, not a construction.
+//
+// The layout is the native one of this build (little-endian, the compiler's padding);
+// size records sizeof(ModelBlob), so a blob from a build with a different layout is
+// refused instead of being misread.
+
+const uint32_t MODEL_BLOB_MAGIC = 0x4C444D46;        // "FMDL" in flash byte order
+const uint16_t MODEL_BLOB_VERSION = 1;
+const uint16_t MODEL_BLOB_HAS_OUTPUT_TABLE = 0x0001; // flags: outputTable is filled in
+
+struct ModelBlob {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint32_t size;
+  FuzzyModel model;
+  uint8_t outputTable[MODEL_OUTPUT_SETS][OUTPUT_TABLE_SAMPLES];
+  uint16_t checksum; // crc16Ccitt() of the bytes before it
+};
+
+// A model compiled into the sketch under a name, e.g. one per crop (CropProfiles.h)
+struct ModelProfile {
+  const char* name;
+  const ModelBlob* blob;
+};
+
+// Packs model into blob, with the output table if withTable, and seals it with the
+// checksum. Padding bytes are zeroed, so the same model always gives the same bytes.
+void buildModelBlob(const FuzzyModel& model, bool withTable, ModelBlob& blob);
+
+// Checks that data (size bytes) starts with a blob of this build: magic, version, size,
+// checksum and validateModel(). Returns it in place (nothing is copied), NULL if any
+// check fails.
+const ModelBlob* mapModelBlob(const void* data, size_t size);
+
+// Erases the start of store and writes blob there. False if the store is too small or
+// the flash operations fail.
+bool storeModelBlob(FlashStore& store, const ModelBlob& blob);
+
+// Runs the blob's model, with its output table if it has one
+inline void runInference(const ModelBlob& blob, const float inputs[MODEL_INPUTS], InferenceResult& result) {
+  runInference(blob.model, (blob.flags & MODEL_BLOB_HAS_OUTPUT_TABLE) ? blob.outputTable : NULL, inputs, result);
+}
+
+#endif // End of include guard
@@ -0,0 +1,75 @@
+// ModelSlot.h
+#ifndef ModelSlot_h // Include guard to prevent multiple inclusions
+#define ModelSlot_h
+
+#include <atomic>
+#include <stdint.h>
+#include "ModelBlob.h"
+
+// The model inference runs on, swapped atomically by one writer (the console side).
+//
+// The slot holds a pointer, so a swap is one store whatever the model's size: a blob
+// compiled into flash, one mapped from the model partition or one of the slot's two RAM
+// buffers (for models built at runtime) all cost the same. The inference side takes the
+// current model with acquire() and may use it until its next acquire(); it never waits
+// and never sees a half-written model, because a buffer is only refilled when neither
+// the current pointer nor the reader's announced one refers to it.
+//
+// Only ONE context may acquire (the inference side), and only one may write.
+class ModelSlot {
+  public:
+    ModelSlot() : active(NULL), reading(NULL), swaps(0) {}
+
+    // Reader side: the model to run and, in version, the number of swaps it includes.
+    // The returned blob stays valid until the next acquire(). NULL before the first publish().
+    const ModelBlob* acquire(uint32_t& version) {
+      version = swaps.load(std::memory_order_seq_cst); // Before the pointer: the blob is at least this new
+      const ModelBlob* blob = active.load(std::memory_order_seq_cst);
+      for (;;) {
+        reading.store(blob, std::memory_order_seq_cst); // Announce it, then check it is still current
+        const ModelBlob* again = active.load(std::memory_order_seq_cst);
+        if (again == blob) {
+          return blob;
+        }
+        blob = again;
+      }
+    }
+
+    // Writer side: a RAM buffer that inference can't be using, to fill and publish().
+    // NULL while both are in use (the reader still holds the previous model); try again
+    // after its next acquire().
+    ModelBlob* editBuffer() {
+      for (uint8_t i = 0; i < 2; i++) {
+        if (!referenced(&buffers[i])) {
+          return &buffers[i];
+        }
+      }
+      return NULL;
+    }
+
+    // Writer side: makes blob (a valid model that stays unchanged while in use) current.
+    void publish(const ModelBlob* blob) {
+      active.store(blob, std::memory_order_seq_cst);
+      swaps.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    // Writer side: true if blob is current or may still be read by inference, so its
+    // memory (a RAM buffer, or flash about to be erased) must not change.
+    bool referenced(const ModelBlob* blob) const {
+      return active.load(std::memory_order_seq_cst) == blob || reading.load(std::memory_order_seq_cst) == blob;
+    }
+
+    // Writer side: the model published last.
+    const ModelBlob* current() const { return active.load(std::memory_order_relaxed); }
+
+    // Number of publish() calls so far.
+    uint32_t version() const { return swaps.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<const ModelBlob*> active;  // Current model
+    std::atomic<const ModelBlob*> reading; // Model the reader announced last
+    std::atomic<uint32_t> swaps;
+    ModelBlob buffers[2];
+};
+
+#endif // End of include guard
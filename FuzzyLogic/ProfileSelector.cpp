@@ -0,0 +1,66 @@
+// ProfileSelector.cpp
+#include "ProfileSelector.h" // Include the header file we just defined
+
+static const unsigned long HOUR_MILLIS = 3600000UL;
+
+// Constructor implementation
+ProfileSelector::ProfileSelector(const uint8_t* pins, uint8_t pinCount, const ProfileStep* schedule, uint8_t stepCount) :
+  pins(pins),
+  pinCount(pinCount < MAX_PINS ? pinCount : MAX_PINS),
+  schedule(schedule),
+  stepCount(stepCount),
+  nextStep(0),
+  stablePins(0),
+  changedPins(0),
+  changedMillis(0),
+  lastMillis(0),
+  partialMillis(0),
+  hours(0) {
+}
+
+// begin method implementation
+uint8_t ProfileSelector::begin(unsigned long nowMillis) {
+  for (uint8_t i = 0; i < pinCount; i++) {
+    pinMode(pins[i], INPUT_PULLUP);
+  }
+  stablePins = changedPins = readPins();
+  changedMillis = lastMillis = nowMillis;
+  return stablePins != 0 ? stablePins : NONE;
+}
+
+// poll method implementation
+uint8_t ProfileSelector::poll(unsigned long nowMillis) {
+  uint8_t profile = NONE;
+
+  uint8_t pinProfile = readPins();
+  if (pinProfile != changedPins) {
+    changedPins = pinProfile; // Bouncing or just moved: wait until it settles
+    changedMillis = nowMillis;
+  } else if (pinProfile != stablePins && nowMillis - changedMillis >= SETTLE_MILLIS) {
+    stablePins = pinProfile;
+    profile = pinProfile;
+  }
+
+  // Uptime in whole hours, from millis() differences so the wrap after 49 days is harmless
+  partialMillis += nowMillis - lastMillis;
+  lastMillis = nowMillis;
+  while (partialMillis >= HOUR_MILLIS) {
+    partialMillis -= HOUR_MILLIS;
+    hours++;
+  }
+  while (nextStep < stepCount && hours >= schedule[nextStep].fromHours) {
+    profile = schedule[nextStep++].profile; // Several steps passed at once: the last one counts
+  }
+  return profile;
+}
+
+// readPins method implementation
+uint8_t ProfileSelector::readPins() const {
+  uint8_t profile = 0;
+  for (uint8_t i = 0; i < pinCount; i++) {
+    if (digitalRead(pins[i]) == LOW) {
+      profile |= 1 << i;
+    }
+  }
+  return profile;
+}
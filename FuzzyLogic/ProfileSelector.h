@@ -0,0 +1,60 @@
+// ProfileSelector.h
+#ifndef ProfileSelector_h // Include guard to prevent multiple inclusions
+#define ProfileSelector_h
+
+#include <Arduino.h>
+
+// One step of a profile schedule: from fromHours of uptime on, run profile
+struct ProfileStep {
+  uint16_t fromHours;
+  uint8_t profile;
+};
+
+// Picks the controller profile from outside the console: jumpers on the select pins and
+// a schedule over uptime. It only says which profile to switch to; the caller switches
+// (TuningConsole::selectProfile()), so whichever source asked last wins.
+//
+// The select pins are inputs with pull-ups, and a jumper to GND sets a bit: together they
+// are a binary profile number, the first pin being the lowest bit. A changed number is
+// taken once it has been stable for SETTLE_MILLIS, so the jumpers can be moved while the
+// controller runs (back to no jumpers selects profile 0). At boot, no jumpers means "not
+// selected by pins", so a stored model still starts.
+//
+// The schedule switches to a step's profile once its start has passed, e.g. seedlings for
+// three weeks and tomatoes after that. There is no clock, so it counts uptime and starts
+// over after a reset; millis() wrapping around is handled.
+class ProfileSelector {
+  public:
+    static const uint8_t NONE = 0xFF;                  // poll(): nothing to switch to
+    static const uint8_t MAX_PINS = 3;
+    static const unsigned long SETTLE_MILLIS = 200;
+
+    // Extra pins beyond MAX_PINS are ignored. Steps must be in order of fromHours.
+    ProfileSelector(const uint8_t* pins, uint8_t pinCount, const ProfileStep* schedule, uint8_t stepCount);
+
+    // Sets the pins up. Returns the jumpered profile number, NONE if no jumper is set.
+    uint8_t begin(unsigned long nowMillis);
+
+    // Profile to switch to now, NONE if nothing changed. Call often.
+    uint8_t poll(unsigned long nowMillis);
+
+  private:
+    // Profile number the jumpers set right now
+    uint8_t readPins() const;
+
+    const uint8_t* pins;
+    uint8_t pinCount;
+    const ProfileStep* schedule;
+    uint8_t stepCount;
+    uint8_t nextStep;             // First schedule step not reached yet
+
+    uint8_t stablePins;           // Number last taken from the pins
+    uint8_t changedPins;          // Number read last, waiting to be stable
+    unsigned long changedMillis;  // When changedPins was first read
+
+    unsigned long lastMillis;
+    unsigned long partialMillis;  // Uptime not yet counted in hours
+    uint16_t hours;
+};
+
+#endif // End of include guard
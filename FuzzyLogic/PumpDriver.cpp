@@ -0,0 +1,98 @@
+// PumpDriver.cpp
+#include "PumpDriver.h" // Include the header file we just defined
+
+// Constructor implementation
+PumpDriver::PumpDriver(uint8_t pin, float minPower, float rampPercentPerSecond,
+                       unsigned long minOnMillis, unsigned long maxSampleAgeMillis) :
+  pin(pin),
+  minPower(minPower),
+  rampPerSecond(rampPercentPerSecond),
+  minOnMicros(minOnMillis * 1000),
+  maxSampleAgeMicros(maxSampleAgeMillis * 1000),
+  demandPower(0),
+  outputPower(0),
+  duty(0),
+  following(false),
+  freshUntilMicros(0),
+  startMicros(0),
+  lastUpdateMicros(0),
+  latencyMicros(0),
+  startCount(0),
+  staleStopCount(0) {
+}
+
+// begin method implementation
+bool PumpDriver::begin() {
+  lastUpdateMicros = micros();
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR < 3
+  // arduino-esp32 2.x: channel-based LEDC API, channel 0 for the pump
+  if (ledcSetup(0, PWM_FREQUENCY, PWM_BITS) == 0) {
+    return false;
+  }
+  ledcAttachPin(pin, 0);
+  ledcWrite(0, 0);
+#else
+  if (!ledcAttach(pin, PWM_FREQUENCY, PWM_BITS)) {
+    return false;
+  }
+  ledcWrite(pin, 0);
+#endif
+  duty = 0;
+  return true;
+}
+
+// command method implementation
+unsigned long PumpDriver::command(float power, unsigned long sampleMicros, unsigned long inputAgeMillis) {
+  unsigned long nowMicros = micros();
+  unsigned long inputAgeMicros = inputAgeMillis * 1000;
+  demandPower = constrain(power, 0.0f, 100.0f);
+  freshUntilMicros = nowMicros + (inputAgeMicros < maxSampleAgeMicros ? maxSampleAgeMicros - inputAgeMicros : 0);
+  following = true;
+  update(nowMicros);
+  latencyMicros = micros() - sampleMicros; // The duty cycle for this sample is written
+  return latencyMicros;
+}
+
+// update method implementation
+void PumpDriver::update(unsigned long nowMicros) {
+  float elapsedSeconds = (nowMicros - lastUpdateMicros) / 1000000.0f;
+  lastUpdateMicros = nowMicros;
+
+  if (following && (long)(nowMicros - freshUntilMicros) >= 0) {
+    // The decision is based on a reading too old to act on: stop until a fresh command
+    following = false;
+    demandPower = 0;
+    if (outputPower > 0) {
+      outputPower = 0;
+      staleStopCount++;
+    }
+  }
+
+  float target = demandPower >= minPower ? demandPower : 0; // Below minPower the pump stalls
+  if (outputPower <= 0 && target > 0) {
+    outputPower = minPower; // Start at the lowest power it runs at, then ramp
+    startMicros = nowMicros;
+    startCount++;
+  } else if (target > outputPower) {
+    outputPower = min(target, outputPower + rampPerSecond * elapsedSeconds);
+  } else if (outputPower > 0 && nowMicros - startMicros < minOnMicros) {
+    outputPower = max(target, minPower); // Keep running until the minimum on-time is over
+  } else {
+    outputPower = target;
+  }
+  writeOutput();
+}
+
+// writeOutput method implementation
+void PumpDriver::writeOutput() {
+  uint32_t newDuty = (uint32_t)lround(outputPower * PWM_MAX / 100.0f);
+  if (newDuty == duty) {
+    return;
+  }
+  duty = newDuty;
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR < 3
+  ledcWrite(0, duty);
+#else
+  ledcWrite(pin, duty);
+#endif
+}
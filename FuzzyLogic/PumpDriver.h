@@ -0,0 +1,80 @@
+// PumpDriver.h
+#ifndef PumpDriver_h // Include guard to prevent multiple inclusions
+#define PumpDriver_h
+
+#include <Arduino.h>
+
+// Drives the water pump with PWM from the inference result.
+//
+// The inference side calls command() with every new pump power, the micros() time of the
+// newest sensor sample it was computed from and the age of its oldest input. The duty
+// cycle is written in the same call, so the sensor-to-actuation latency is the age of the
+// sample plus the inference time; it is measured on every command (lastLatencyMicros()).
+// Between commands, update() moves the output on:
+//
+//   - Soft start: the pump starts at minPower (below it, it stalls; smaller demands mean
+//     off) and rises at most rampPercentPerSecond, so it never gets full power from rest.
+//     Lower demands are followed at once.
+//   - Minimum on-time: once started, it runs at least minOnMillis (at minPower or more),
+//     so a demand hovering around minPower doesn't switch it on and off every second.
+//   - Freshness bound: the pump only follows decisions whose oldest input is at most
+//     maxSampleAgeMillis old. When no fresher command arrives in time (inputs invalid,
+//     inference stalled, or one sensor failing and its last value kept while the others
+//     still update), the pump is stopped at once, whatever the minimum on-time.
+//
+// The output is LEDC PWM at PWM_FREQUENCY (above hearing) with PWM_BITS of resolution,
+// for a MOSFET or motor driver on pin. The host build writes to the mock PWM in MockHal.
+// All calls must come from one context (the inference side).
+class PumpDriver {
+  public:
+    static const uint32_t PWM_FREQUENCY = 20000;
+    static const uint8_t PWM_BITS = 10;
+    static const uint32_t PWM_MAX = (1UL << PWM_BITS) - 1;
+
+    PumpDriver(uint8_t pin, float minPower, float rampPercentPerSecond,
+               unsigned long minOnMillis, unsigned long maxSampleAgeMillis);
+
+    // Sets up the PWM output with the pump off. False if the pin can't do PWM.
+    bool begin();
+
+    // New pump power (percent) computed from inputs whose newest sample was taken at
+    // sampleMicros and whose oldest one is inputAgeMillis old. Applied at once (a command
+    // on inputs already too old stops the pump); returns the latency from the newest
+    // sample to the PWM update.
+    unsigned long command(float power, unsigned long sampleMicros, unsigned long inputAgeMillis);
+
+    // Advances the ramp, the minimum on-time and the freshness bound. Call every pass.
+    void update(unsigned long nowMicros);
+
+    float demand() const { return demandPower; }   // Last commanded power, percent
+    float output() const { return outputPower; }   // Power applied now, percent
+    bool running() const { return outputPower > 0; }
+    unsigned long lastLatencyMicros() const { return latencyMicros; }
+
+    // Starts from rest, and stops because no command on fresh readings arrived
+    uint32_t starts() const { return startCount; }
+    uint32_t staleStops() const { return staleStopCount; }
+
+  private:
+    // Writes the duty cycle of outputPower if it changed
+    void writeOutput();
+
+    uint8_t pin;
+    float minPower;
+    float rampPerSecond;
+    unsigned long minOnMicros;
+    unsigned long maxSampleAgeMicros;
+
+    float demandPower;
+    float outputPower;
+    uint32_t duty;                // Duty cycle written last
+    bool following;               // A command is being followed (not stopped as stale)
+    unsigned long freshUntilMicros; // When the oldest input of that command gets too old
+    unsigned long startMicros;    // When the pump last started from rest
+    unsigned long lastUpdateMicros;
+    unsigned long latencyMicros;
+
+    uint32_t startCount, staleStopCount;
+};
+
+#endif // End of include guard
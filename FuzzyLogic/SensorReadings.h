@@ -0,0 +1,52 @@
+// SensorReadings.h
+#ifndef SensorReadings_h // Include guard to prevent multiple inclusions
+#define SensorReadings_h
+
+#include <Arduino.h>
+
+// Latest value of every reading in the system, each with the millis() time it was
+// last updated. Shared between contexts through a Seqlock so consumers always get all
+// fields from the same generation.
+struct SensorReadings {
+  float temperature;   // Latest valid temperature (NAN until the first valid read)
+  float humidity;      // Latest valid humidity (NAN until the first valid read)
+  float soilMoisture;  // Latest soil moisture percentage (NAN until the first read)
+  float pumpPower;     // Latest defuzzified pump power (0 until the first inference)
+
+  unsigned long temperatureMillis;  // millis() when temperature was last updated
+  unsigned long humidityMillis;     // millis() when humidity was last updated
+  unsigned long soilMoistureMillis; // millis() when soilMoisture was last updated
+  unsigned long pumpPowerMillis;    // millis() when pumpPower was last updated
+
+  unsigned long sampleMicros;       // micros() of the most recent sensor update (for latency)
+
+  uint32_t dhtFailures;             // Failed DHT reads so far (the values above were kept)
+
+  SensorReadings() :
+    temperature(NAN), humidity(NAN), soilMoisture(NAN), pumpPower(0),
+    temperatureMillis(0), humidityMillis(0), soilMoistureMillis(0), pumpPowerMillis(0),
+    sampleMicros(0), dhtFailures(0) {
+  }
+};
+
+// Age of a field in milliseconds, given its timestamp and the current millis().
+// Unsigned subtraction keeps this correct across the millis() rollover.
+inline unsigned long readingAge(unsigned long stampMillis, unsigned long nowMillis) {
+  return nowMillis - stampMillis;
+}
+
+// Converts a raw soil moisture ADC reading to a percentage.
+// Assumes higher raw value means drier soil; 4095 is the max ADC value (12-bit for ESP32).
+inline float soilPercentFromRaw(int soilMoistureRaw) {
+  float calculatedSoilMoisture = (1.0 - (soilMoistureRaw / 4095.0)) * 100.0; 
+  
+  // Clamp values based on raw readings
+  if (soilMoistureRaw >= 4095) calculatedSoilMoisture = 0; 
+  // For typical resistive sensors, raw value 0 is very wet (100%)
+  // The formula (1.0 - (0 / 4095.0)) * 100.0 gives 100.
+  
+  // Ensure calculatedSoilMoisture stays within 0-100 range if needed after formula
+  return constrain(calculatedSoilMoisture, 0.0, 100.0);
+}
+
+#endif // End of include guard
@@ -0,0 +1,72 @@
+// SensorTasks.cpp
+#include "SensorTasks.h" // Include the header file we just defined
+
+#if FUZZY_COROUTINES
+
+// dhtTask implementation
+CoTask dhtTask(DhtCapture& sensor, Seqlock<SensorReadings>& state, unsigned long periodMillis,
+               unsigned long firstDelayMillis) {
+  unsigned long nextRead = millis() + firstDelayMillis; // DHT22 needs time to stabilize after power-up
+  for (;;) {
+    co_await sleepUntil(nextRead);
+    nextRead += periodMillis;
+
+    sensor.beginStart();
+    co_await sleepFor(2); // Start signal: at least 1 ms low
+    sensor.beginCapture();
+    co_await waitUntil(DhtCapture::isCompleteCallback, &sensor, 10); // Full response takes ~5 ms
+
+    float temp, humid;
+    if (sensor.decode(temp, humid)) {
+      SensorReadings& readings = state.beginWrite();
+      readings.temperature = temp;
+      readings.temperatureMillis = millis();
+      readings.humidity = humid;
+      readings.humidityMillis = readings.temperatureMillis;
+      readings.sampleMicros = micros();
+      state.endWrite();
+    } else {
+      state.beginWrite().dhtFailures++;
+      state.endWrite();
+    }
+  }
+}
+
+// soilTask implementation
+CoTask soilTask(uint8_t pin, Seqlock<SensorReadings>& state, unsigned long periodMillis,
+                unsigned long firstDelayMillis) {
+  unsigned long nextRead = millis() + firstDelayMillis;
+  for (;;) {
+    co_await sleepUntil(nextRead);
+    nextRead += periodMillis;
+
+    int soilMoistureRaw = analogRead(pin);
+    SensorReadings& readings = state.beginWrite();
+    readings.soilMoisture = soilPercentFromRaw(soilMoistureRaw);
+    readings.soilMoistureMillis = millis();
+    readings.sampleMicros = micros();
+    state.endWrite();
+  }
+}
+
+// periodicTask implementation
+CoTask periodicTask(void (*step)(unsigned long), unsigned long periodMillis,
+                    bool (*early)(void*), void* context) {
+  unsigned long nextRun = millis() + periodMillis;
+  for (;;) {
+    if (early != NULL) {
+      long remaining = (long)(nextRun - millis());
+      co_await waitUntil(early, context, remaining > 0 ? remaining : 0); // Whichever comes first
+      if (early(context)) {
+        early = NULL;       // Only until the first early call
+        nextRun = millis(); // The fixed schedule starts from here
+      }
+    } else {
+      co_await sleepUntil(nextRun);
+    }
+    nextRun += periodMillis;
+    step(millis());
+  }
+}
+
+#endif // FUZZY_COROUTINES
@@ -0,0 +1,38 @@
+// SensorTasks.h
+#ifndef SensorTasks_h // Include guard to prevent multiple inclusions
+#define SensorTasks_h
+
+#include "FuzzyConfig.h"
+
+#if FUZZY_COROUTINES
+
+#include "CoTask.h"
+#include "DhtCapture.h"
+#include "Seqlock.h"
+#include "SensorReadings.h"
+
+// Coroutines for the sketch's periodic work. They only use the Arduino HAL
+// (pinMode/digitalWrite/analogRead/attachInterrupt/millis/micros), so the same code runs
+// on the ESP32 and in the host build against the mock HAL (see host/).
+
+// Reads the DHT22 every periodMillis, the first time after firstDelayMillis (the sensor
+// needs about a second after power-up): start pulse, edge capture, decode, publish.
+// Failed reads keep the previous values and timestamps in state and are counted there.
+CoTask dhtTask(DhtCapture& sensor, Seqlock<SensorReadings>& state, unsigned long periodMillis,
+               unsigned long firstDelayMillis);
+
+// Reads the soil moisture ADC on pin every periodMillis, the first time after
+// firstDelayMillis, and publishes the percentage.
+CoTask soilTask(uint8_t pin, Seqlock<SensorReadings>& state, unsigned long periodMillis,
+                unsigned long firstDelayMillis);
+
+// Calls step(millis()) every periodMillis on a fixed schedule (no drift).
+// Used for inference + display refresh. If early is given, the first call also happens
+// as soon as early(context) returns true (e.g. once all inputs are valid), and the
+// schedule continues from there.
+CoTask periodicTask(void (*step)(unsigned long), unsigned long periodMillis,
+                    bool (*early)(void*) = NULL, void* context = NULL);
+
+#endif // FUZZY_COROUTINES
+
+#endif // End of include guard
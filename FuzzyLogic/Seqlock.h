@@ -0,0 +1,63 @@
+// Seqlock.h
+#ifndef Seqlock_h // Include guard to prevent multiple inclusions
+#define Seqlock_h
+
+#include <atomic>
+#include <stdint.h>
+
+// Sequence lock protecting a small plain-data value (a struct of readings).
+// One writer updates the value in place; any number of readers (tasks on either core,
+// or interrupt handlers) copy it out without locks and without disabling interrupts.
+// The sequence counter is odd while a write is in progress; a reader retries if the
+// counter was odd or changed during its copy, so it never sees a torn mix of old and
+// new fields.
+//
+// Only ONE context may write. Readers never block the writer.
+template <typename T>
+class Seqlock {
+  public:
+    Seqlock() : sequence(0), value() {}
+
+    // Writer side: starts an update and returns the value to modify in place.
+    // Must be paired with endWrite().
+    T& beginWrite() {
+      sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // Now odd
+      std::atomic_thread_fence(std::memory_order_release);
+      return value;
+    }
+
+    // Writer side: publishes the update started by beginWrite().
+    void endWrite() {
+      sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release); // Even again
+    }
+
+    // Reader side: returns a consistent copy, retrying while a write is in progress.
+    // Do not call from an interrupt that may have interrupted the writer; use tryRead() there.
+    T read() const {
+      T copy;
+      while (!tryRead(copy)) {
+      }
+      return copy;
+    }
+
+    // Reader side: one attempt at a consistent copy. Returns false if a write was in progress
+    // (copy is then undefined) so interrupt handlers can skip instead of spinning.
+    bool tryRead(T& copy) const {
+      uint32_t before = sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        return false;
+      }
+      copy = value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    // Number of completed writes so far (the snapshot generation).
+    uint32_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+  private:
+    std::atomic<uint32_t> sequence; // Twice the number of completed writes, +1 while writing
+    T value;
+};
+
+#endif // End of include guard
@@ -0,0 +1,218 @@
+// SeriesCodec.cpp
+#include "SeriesCodec.h" // Include the header file we just defined
+#include "FixedFormat.h"
+
+// Mask byte: which fields follow (in this order)
+static const uint8_t FIELD_BOOT = 0x01;        // Boot number delta
+static const uint8_t FIELD_TIME = 0x02;        // Timestamp delta-of-delta
+static const uint8_t FIELD_TEMPERATURE = 0x04; // Reading deltas, tenths
+static const uint8_t FIELD_HUMIDITY = 0x08;
+static const uint8_t FIELD_SOIL = 0x10;
+static const uint8_t FIELD_PUMP = 0x20;
+static const uint8_t FIELD_FLAGS = 0x40;       // Flags byte, as is
+static const uint8_t FIELD_INVALID = 0x80;     // Never set (keeps erased 0xFF bytes invalid)
+
+static const uint8_t MAX_SAMPLE_BYTES = 1 + 6 * 5 + 1; // Mask, six varints, flags
+
+// Zigzag varint writer: small magnitudes of either sign in few bytes
+static uint8_t* putVarint(uint8_t* p, int32_t value) {
+  uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+  while (zigzag >= 0x80) {
+    *p++ = (uint8_t)(zigzag | 0x80);
+    zigzag >>= 7;
+  }
+  *p++ = (uint8_t)zigzag;
+  return p;
+}
+
+// Constructor implementation
+SeriesEncoder::SeriesEncoder() :
+  out(NULL),
+  capacity(0),
+  used(0),
+  samples(0),
+  previous(),
+  previousInterval(0) {
+}
+
+// begin method implementation
+void SeriesEncoder::begin(uint8_t* block, size_t blockCapacity) {
+  out = block;
+  capacity = blockCapacity;
+  used = 0;
+  samples = 0;
+  previous = FlashLogRecord();
+  previousInterval = 0;
+}
+
+// add method implementation
+bool SeriesEncoder::add(const FlashLogRecord& record) {
+  uint8_t sample[MAX_SAMPLE_BYTES];
+  uint8_t* p = sample + 1;
+  uint8_t mask = 0;
+
+  int32_t bootDelta = (int16_t)(record.boot - previous.boot);
+  if (bootDelta != 0) {
+    mask |= FIELD_BOOT;
+    p = putVarint(p, bootDelta);
+  }
+  int32_t interval = (int32_t)(record.uptimeSeconds - previous.uptimeSeconds);
+  int32_t deltaOfDelta = interval - previousInterval;
+  if (deltaOfDelta != 0) {
+    mask |= FIELD_TIME;
+    p = putVarint(p, deltaOfDelta);
+  }
+  const int16_t values[4] = {record.temperature, record.humidity, record.soilMoisture, record.pumpPower};
+  const int16_t before[4] = {previous.temperature, previous.humidity, previous.soilMoisture, previous.pumpPower};
+  for (uint8_t i = 0; i < 4; i++) {
+    int32_t delta = (int32_t)values[i] - before[i];
+    if (delta != 0) {
+      mask |= FIELD_TEMPERATURE << i;
+      p = putVarint(p, delta);
+    }
+  }
+  if (record.flags != previous.flags) {
+    mask |= FIELD_FLAGS;
+    *p++ = record.flags;
+  }
+  sample[0] = mask;
+
+  size_t length = p - sample;
+  if (used + length > capacity) {
+    return false;
+  }
+  memcpy(out + used, sample, length);
+  used += length;
+  // The first interval of a block is measured from zero: don't predict the next from it
+  previousInterval = samples == 0 ? 0 : interval;
+  previous = record;
+  samples++;
+  return true;
+}
+
+// Constructor implementation
+SeriesDecoder::SeriesDecoder(const uint8_t* block, size_t size) :
+  block(block),
+  size(size),
+  position(0),
+  samples(0),
+  previous(),
+  previousInterval(0) {
+}
+
+// readVarint method implementation
+bool SeriesDecoder::readVarint(int32_t& value) {
+  uint32_t zigzag = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (position >= size) {
+      return false;
+    }
+    uint8_t byte = block[position++];
+    zigzag |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      value = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+      return true;
+    }
+  }
+  return false; // More than 5 bytes: not something the encoder wrote
+}
+
+// next method implementation
+bool SeriesDecoder::next(FlashLogRecord& record) {
+  if (position >= size) {
+    return false;
+  }
+  uint8_t mask = block[position++];
+  if (mask & FIELD_INVALID) {
+    return false;
+  }
+  record = previous;
+  int32_t value = 0;
+
+  if (mask & FIELD_BOOT) {
+    if (!readVarint(value)) return false;
+    record.boot = previous.boot + value;
+  }
+  int32_t deltaOfDelta = 0;
+  if (mask & FIELD_TIME) {
+    if (!readVarint(deltaOfDelta)) return false;
+  }
+  int32_t interval = previousInterval + deltaOfDelta;
+  record.uptimeSeconds = previous.uptimeSeconds + interval;
+
+  int16_t* values[4] = {&record.temperature, &record.humidity, &record.soilMoisture, &record.pumpPower};
+  for (uint8_t i = 0; i < 4; i++) {
+    if (mask & (FIELD_TEMPERATURE << i)) {
+      if (!readVarint(value)) return false;
+      *values[i] = (int16_t)(*values[i] + value);
+    }
+  }
+  if (mask & FIELD_FLAGS) {
+    if (position >= size) return false;
+    record.flags = block[position++];
+  }
+
+  previousInterval = samples == 0 ? 0 : interval;
+  previous = record;
+  samples++;
+  return true;
+}
+
+#if FUZZY_BENCHMARK
+// Sample number i of the benchmark series
+static FlashLogRecord benchmarkSample(uint32_t i) {
+  float day = (float)i / 8640.0f; // One sample per 10 s
+  FlashLogRecord record;
+  record.boot = 1;
+  record.uptimeSeconds = i * 10;
+  record.temperature = toTenths16(24.0f + 6.0f * sinf(day * 6.283f));
+  record.humidity = toTenths16(55.0f - 15.0f * sinf(day * 6.283f));
+  float soil = 40.0f + 20.0f * cosf(day * 31.4f);
+  record.soilMoisture = toTenths16(soil);
+  record.pumpPower = toTenths16(soil < 30.0f ? 60.0f : 0.0f);
+  record.flags = FLASH_LOG_INPUTS_VALID;
+  return record;
+}
+
+// benchmarkSeriesCodec function implementation
+SeriesBenchmark benchmarkSeriesCodec(uint32_t samples, size_t blockSize) {
+  SeriesBenchmark result = {samples, 0, 0, 0};
+  uint8_t block[256];
+  blockSize = min(blockSize, sizeof(block));
+  FlashLogRecord records[32]; // Generated outside the timed loops
+
+  SeriesEncoder encoder;
+  encoder.begin(block, blockSize);
+  for (uint32_t start = 0; start < samples; start += 32) {
+    uint32_t batch = min((uint32_t)32, samples - start);
+    for (uint32_t i = 0; i < batch; i++) {
+      records[i] = benchmarkSample(start + i);
+    }
+    unsigned long t0 = micros(); // Whole batches: add() is too short to time one by one
+    for (uint32_t i = 0; i < batch; i++) {
+      if (encoder.add(records[i])) continue;
+
+      // Block full: decode it (timed separately), then start the next one with this sample
+      unsigned long t1 = micros();
+      result.encodeMicros += t1 - t0;
+      result.bytes += encoder.size();
+      SeriesDecoder decoder(block, encoder.size());
+      FlashLogRecord decoded;
+      while (decoder.next(decoded)) {}
+      t0 = micros();
+      result.decodeMicros += t0 - t1;
+      encoder.begin(block, blockSize);
+      encoder.add(records[i]);
+    }
+    result.encodeMicros += micros() - t0;
+  }
+  // The last, partial block
+  unsigned long t1 = micros();
+  SeriesDecoder decoder(block, encoder.size());
+  FlashLogRecord decoded;
+  while (decoder.next(decoded)) {}
+  result.decodeMicros += micros() - t1;
+  result.bytes += encoder.size();
+  return result;
+}
+#endif
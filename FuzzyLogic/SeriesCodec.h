@@ -0,0 +1,88 @@
+// SeriesCodec.h
+#ifndef SeriesCodec_h // Include guard to prevent multiple inclusions
+#define SeriesCodec_h
+
+#include <Arduino.h>
+#include "FuzzyConfig.h"
+
+// One logged sample: what survives a reboot.
+struct FlashLogRecord {
+  uint16_t boot;          // Boot number (FlashLog::bootNumber() when it was logged)
+  uint32_t uptimeSeconds; // Seconds since that boot
+  int16_t temperature;    // Tenths of a degree C (TENTHS16_NAN = no reading)
+  int16_t humidity;       // Tenths of a percent
+  int16_t soilMoisture;   // Tenths of a percent
+  int16_t pumpPower;      // Tenths of a percent
+  uint8_t flags;          // FLASH_LOG_INPUTS_VALID
+};
+
+const uint8_t FLASH_LOG_INPUTS_VALID = 0x01;
+
+// Streaming compression of the logged series into self-contained blocks.
+//
+// Each sample is stored as the change from the previous sample of the block:
+//   - a mask byte telling which fields changed (unchanged fields take no space),
+//   - the timestamp as delta-of-delta: with a steady logging interval it is 0, so the
+//     time normally costs nothing,
+//   - the readings, already quantized to tenths, as integer deltas,
+//   - every number as a zigzag varint (small positive and negative values in one byte).
+// Slowly drifting readings and an idle pump then take about 2-4 bytes per sample instead
+// of 16. The first sample of a block is coded against zero, so every block decodes on its
+// own (a lost block loses only its samples).
+class SeriesEncoder {
+  public:
+    SeriesEncoder();
+
+    // Starts a new block in out (capacity bytes).
+    void begin(uint8_t* out, size_t capacity);
+
+    // Appends a sample. False (block unchanged) if it doesn't fit; start a new block then.
+    bool add(const FlashLogRecord& record);
+
+    // Bytes and samples in the block so far.
+    size_t size() const { return used; }
+    uint16_t count() const { return samples; }
+
+  private:
+    uint8_t* out;
+    size_t capacity;
+    size_t used;
+    uint16_t samples;
+    FlashLogRecord previous; // Last sample of the block (all zero before the first)
+    int32_t previousInterval;
+};
+
+// Reads the samples of a block written by SeriesEncoder.
+class SeriesDecoder {
+  public:
+    SeriesDecoder(const uint8_t* block, size_t size);
+
+    // Next sample of the block. False at the end of the block or on malformed data.
+    bool next(FlashLogRecord& record);
+
+  private:
+    // Reads one zigzag varint. False if it runs past the block or is too long.
+    bool readVarint(int32_t& value);
+
+    const uint8_t* block;
+    size_t size;
+    size_t position;
+    uint16_t samples;
+    FlashLogRecord previous;
+    int32_t previousInterval;
+};
+
+#if FUZZY_BENCHMARK
+// Encodes and decodes a synthetic day-like series (slow temperature/humidity drift, soil
+// moisture cycles with pump bursts, one sample per 10 s) block by block.
+struct SeriesBenchmark {
+  uint32_t samples;
+  uint32_t bytes;            // Encoded size, all blocks
+  unsigned long encodeMicros;
+  unsigned long decodeMicros;
+};
+
+SeriesBenchmark benchmarkSeriesCodec(uint32_t samples, size_t blockSize);
+#endif
+
+#endif // End of include guard
@@ -0,0 +1,20 @@
+// St7735Panel.h
+#ifndef St7735Panel_h // Include guard to prevent multiple inclusions
+#define St7735Panel_h
+
+#include <Adafruit_ST7735.h>
+
+// Adafruit_ST7735 with read access to the panel's RAM offsets for the current rotation.
+// Code that talks to the controller directly (DMA flush, hardware scroll) needs them to
+// address the same pixels as the library does.
+class St7735Panel : public Adafruit_ST7735 {
+  public:
+    St7735Panel(int8_t csPin, int8_t dcPin, int8_t rstPin) : Adafruit_ST7735(csPin, dcPin, rstPin) {}
+
+    int16_t xOffset() const { return _xstart; } // Column offset added to x by setAddrWindow()
+    int16_t yOffset() const { return _ystart; } // Row offset added to y by setAddrWindow()
+    int8_t csPin() const { return _cs; }
+    int8_t dcPin() const { return _dc; }
+};
+
+#endif // End of include guard
@@ -0,0 +1,118 @@
+// Telemetry.cpp
+#include "Telemetry.h" // Include the header file we just defined
+#include "ByteOrder.h"
+#include "Checksum.h"
+
+// telemetryFromFrame function implementation
+void telemetryFromFrame(const ControlFrame& frame, TelemetryRecord& record) {
+  record.temperature = toTenths16(frame.temperature);
+  record.humidity = toTenths16(frame.humidity);
+  record.soilMoisture = toTenths16(frame.soilMoisture);
+  record.pumpPower = toTenths16(frame.pumpPower);
+  record.flags = frame.inputsValid ? TELEMETRY_INPUTS_VALID : 0;
+  memcpy(record.ruleFiring, frame.ruleFiring, sizeof(record.ruleFiring));
+}
+
+// encodeTelemetry function implementation
+size_t encodeTelemetry(const TelemetryRecord& record, uint8_t* out) {
+  // Record bytes
+  uint8_t raw[TELEMETRY_MAX_RECORD];
+  uint8_t* p = raw;
+  *p++ = TELEMETRY_RECORD_FRAME;
+  p = putLe16(p, record.sequence);
+  p = putLe32(p, record.timeMillis);
+  p = putLe16(p, (uint16_t)record.temperature);
+  p = putLe16(p, (uint16_t)record.humidity);
+  p = putLe16(p, (uint16_t)record.soilMoisture);
+  p = putLe16(p, (uint16_t)record.pumpPower);
+  *p++ = record.flags;
+  p = putLe32(p, record.latencyMicros);
+  uint32_t mask = 0;
+  uint8_t* maskField = p;
+  p += 4;
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    if (record.ruleFiring[cell] != 0) {
+      mask |= 1UL << cell;
+      *p++ = record.ruleFiring[cell];
+    }
+  }
+  putLe32(maskField, mask);
+  p = putLe16(p, crc16Ccitt(raw, p - raw));
+  size_t length = p - raw;
+
+  // COBS: every zero byte is replaced by the distance to the next one, each block of up
+  // to 254 data bytes is preceded by such a code byte
+  uint8_t* o = out;
+  *o++ = 0x00;                // Leading delimiter ends whatever came before
+  uint8_t* code = o++;
+  uint8_t run = 1;
+  for (size_t i = 0; i < length; i++) {
+    if (raw[i] == 0) {
+      *code = run;
+      code = o++;
+      run = 1;
+    } else {
+      *o++ = raw[i];
+      if (++run == 0xFF) {    // Full block: start a new one
+        *code = run;
+        code = o++;
+        run = 1;
+      }
+    }
+  }
+  *code = run;
+  *o++ = 0x00;                // Trailing delimiter
+  return o - out;
+}
+
+// decodeTelemetry function implementation
+bool decodeTelemetry(const uint8_t* frame, size_t length, TelemetryRecord& record) {
+  // Undo COBS
+  uint8_t raw[TELEMETRY_MAX_RECORD];
+  size_t size = 0;
+  size_t i = 0;
+  while (i < length) {
+    uint8_t run = frame[i++];
+    if (run == 0 || i + run - 1 > length) {
+      return false;
+    }
+    for (uint8_t k = 1; k < run; k++) {
+      if (size >= sizeof(raw)) return false;
+      raw[size++] = frame[i++];
+    }
+    if (run != 0xFF && i < length) {
+      if (size >= sizeof(raw)) return false;
+      raw[size++] = 0; // The zero this code byte stood for
+    }
+  }
+
+  // Fixed part, CRC and type
+  if (size < 24 + 2 || raw[0] != TELEMETRY_RECORD_FRAME) {
+    return false;
+  }
+  if (crc16Ccitt(raw, size - 2) != getLe16(raw + size - 2)) {
+    return false;
+  }
+  uint32_t mask = getLe32(raw + 20);
+  uint8_t firing = 0;
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    if (mask & (1UL << cell)) firing++;
+  }
+  if (mask >> RULE_GRID_CELLS || size != (size_t)24 + firing + 2) {
+    return false;
+  }
+
+  record.sequence = getLe16(raw + 1);
+  record.timeMillis = getLe32(raw + 3);
+  record.temperature = (int16_t)getLe16(raw + 7);
+  record.humidity = (int16_t)getLe16(raw + 9);
+  record.soilMoisture = (int16_t)getLe16(raw + 11);
+  record.pumpPower = (int16_t)getLe16(raw + 13);
+  record.flags = raw[15];
+  record.latencyMicros = getLe32(raw + 16);
+  const uint8_t* strength = raw + 24;
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    record.ruleFiring[cell] = (mask & (1UL << cell)) ? *strength++ : 0;
+  }
+  return true;
+}
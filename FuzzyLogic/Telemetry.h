@@ -0,0 +1,62 @@
+// Telemetry.h
+#ifndef Telemetry_h // Include guard to prevent multiple inclusions
+#define Telemetry_h
+
+#include <Arduino.h>
+#include "ControlFrame.h"
+#include "FixedFormat.h"
+
+// Compact binary telemetry: one record per rendered frame instead of the text log line.
+//
+// Record layout (little-endian, before framing):
+//   0  uint8   type          TELEMETRY_RECORD_FRAME (layout version)
+//   1  uint16  sequence      Record counter, wraps; gaps show lost records
+//   3  uint32  timeMillis    millis() when the record was made
+//   7  int16   temperature   Tenths of a degree C  (TELEMETRY_NO_VALUE = NAN)
+//   9  int16   humidity      Tenths of a percent   (TELEMETRY_NO_VALUE = NAN)
+//  11  int16   soilMoisture  Tenths of a percent   (TELEMETRY_NO_VALUE = NAN)
+//  13  int16   pumpPower     Tenths of a percent
+//  15  uint8   flags         TELEMETRY_INPUTS_VALID
+//  16  uint32  latencyMicros Sensor-to-pixel latency of the frame
+//  20  uint32  ruleMask      Bit i set = rule grid cell i fired (ControlFrame::ruleFiring)
+//  24  uint8[] strengths     Firing strength of each set bit, lowest cell first
+//   .. uint16  crc           CRC-16/CCITT-FALSE of all bytes above
+//
+// Only firing cells are sent: with at most two sets of each input overlapping, a record
+// carries up to 8 strengths instead of all 27. The record is COBS encoded (no zero bytes
+// inside) and sent between two 0x00 delimiters, so a receiver can start anywhere in the
+// stream, and text written in between (e.g. benchmark lines) costs no record.
+
+const uint8_t TELEMETRY_RECORD_FRAME = 0x01;
+const int16_t TELEMETRY_NO_VALUE = TENTHS16_NAN;
+const uint8_t TELEMETRY_INPUTS_VALID = 0x01;
+
+// Largest record before framing, and largest framed record (COBS overhead + delimiters)
+const size_t TELEMETRY_MAX_RECORD = 24 + RULE_GRID_CELLS + 2;
+const size_t TELEMETRY_MAX_FRAME = TELEMETRY_MAX_RECORD + TELEMETRY_MAX_RECORD / 254 + 1 + 2;
+
+// Decoded content of one record.
+struct TelemetryRecord {
+  uint16_t sequence;
+  uint32_t timeMillis;
+  int16_t temperature;   // Tenths, or TELEMETRY_NO_VALUE
+  int16_t humidity;
+  int16_t soilMoisture;
+  int16_t pumpPower;
+  uint8_t flags;
+  uint32_t latencyMicros;
+  uint8_t ruleFiring[RULE_GRID_CELLS]; // All 27 cells, 0 where the cell didn't fire
+};
+
+// Fills a record from a frame (sequence, time and latency are set by the caller).
+void telemetryFromFrame(const ControlFrame& frame, TelemetryRecord& record);
+
+// Writes record as a complete frame (delimiter, COBS data, delimiter) into out, which must
+// hold TELEMETRY_MAX_FRAME bytes. Returns the number of bytes written.
+size_t encodeTelemetry(const TelemetryRecord& record, uint8_t* out);
+
+// Decodes the COBS data of one frame (the bytes between two delimiters) into record.
+// Returns false if the frame is damaged (bad COBS, size or CRC) or of an unknown type.
+bool decodeTelemetry(const uint8_t* frame, size_t length, TelemetryRecord& record);
+
+#endif // End of include guard
@@ -0,0 +1,52 @@
+// TripleBuffer.h
+#ifndef TripleBuffer_h // Include guard to prevent multiple inclusions
+#define TripleBuffer_h
+
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer "latest value" handoff.
+// The producer always owns one slot (back), the consumer always owns one slot (front),
+// and the third slot (middle) is swapped atomically between them. Neither side ever
+// waits for the other: the producer can publish faster than the consumer reads,
+// in which case intermediate values are simply overwritten, and the consumer
+// always sees the most recently published value in one piece.
+template <typename T>
+class TripleBuffer {
+  public:
+    TripleBuffer() : middle(1), backIndex(0), frontIndex(2) {}
+
+    // Producer side: the slot to fill before calling publish().
+    T& back() { return slots[backIndex]; }
+
+    // Producer side: makes the filled back slot visible to the consumer.
+    void publish() {
+      uint8_t previous = middle.exchange(backIndex | FRESH_BIT, std::memory_order_acq_rel);
+      backIndex = previous & INDEX_MASK; // Reuse whatever slot the consumer isn't holding
+    }
+
+    // Consumer side: takes the latest published value if there is a new one.
+    // Returns false (and leaves front() unchanged) when nothing new was published.
+    bool fetch() {
+      if ((middle.load(std::memory_order_acquire) & FRESH_BIT) == 0) {
+        return false;
+      }
+      uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+      frontIndex = previous & INDEX_MASK;
+      return true;
+    }
+
+    // Consumer side: the value taken by the last successful fetch().
+    const T& front() const { return slots[frontIndex]; }
+
+  private:
+    static const uint8_t INDEX_MASK = 0x03; // Low bits hold a slot index (0-2)
+    static const uint8_t FRESH_BIT = 0x04;  // Set while the middle slot holds an unread value
+
+    T slots[3];
+    std::atomic<uint8_t> middle; // Index of the shared slot plus the FRESH_BIT flag
+    uint8_t backIndex;           // Slot owned by the producer
+    uint8_t frontIndex;          // Slot owned by the consumer
+};
+
+#endif // End of include guard
@@ -0,0 +1,395 @@
+// TuningConsole.cpp
+#include "TuningConsole.h" // Include the header file we just defined
+#include "FixedFormat.h"
+
+// Splits the next space-separated word off text. NULL if there is none.
+static char* nextWord(char*& text) {
+  while (*text == ' ') text++;
+  if (*text == '\0') {
+    return NULL;
+  }
+  char* word = text;
+  while (*text != ' ' && *text != '\0') text++;
+  if (*text == ' ') *text++ = '\0';
+  return word;
+}
+
+// Parses a whole word as a number
+static bool parseNumber(const char* word, float& value) {
+  if (word == NULL) {
+    return false;
+  }
+  char* end;
+  value = (float)strtod(word, &end);
+  return end != word && *end == '\0' && !isnan(value);
+}
+
+// Constructor implementation
+TuningConsole::TuningConsole(ModelSlot& slot, LogBuffer& log, const MetricsRegistry& metrics) :
+  slot(slot),
+  log(log),
+  metrics(metrics),
+  profiles(NULL),
+  profileCount(0),
+  runningProfile(NO_PROFILE),
+  store(NULL),
+  current(),
+  unpublished(false),
+  listing(LIST_NONE),
+  listPosition(0),
+  metricsCursor(),
+  lineLength(0),
+  lineTooLong(false),
+  pendingVersion(0),
+  lastMicros(0),
+  beforeMicros(0) {
+}
+
+// begin method implementation
+void TuningConsole::begin(const ModelProfile* profiles, uint8_t profileCount, FlashStore* store) {
+  this->profiles = profiles;
+  this->profileCount = profileCount;
+  this->store = store;
+  const ModelBlob* stored = storedModel();
+  const ModelBlob* blob = stored != NULL ? stored : profiles[0].blob;
+  runningProfile = stored != NULL ? NO_PROFILE : 0;
+  current = blob->model;
+  slot.publish(blob); // Not timed: there is no cost before it to compare with
+  char text[40];
+  appendText(stored != NULL ? "stored" : profiles[0].name, appendText("Model: ", text));
+  log.writeLine(text);
+}
+
+// selectProfile method implementation
+bool TuningConsole::selectProfile(uint8_t index) {
+  if (index >= profileCount) {
+    log.writeLine("Error: No such profile");
+    return false;
+  }
+  current = profiles[index].blob->model;
+  publish(profiles[index].blob); // Also drops an edit still waiting for a buffer
+  runningProfile = index;
+  char text[40];
+  appendText(profiles[index].name, appendText("Profile: ", text));
+  log.writeLine(text);
+  return true;
+}
+
+// feed method implementation
+bool TuningConsole::feed(char c) {
+  if (c != '\r' && c != '\n') {
+    if (lineLength < LINE_LENGTH) {
+      line[lineLength++] = c;
+    } else {
+      lineTooLong = true;
+    }
+    return false;
+  }
+  line[lineLength] = '\0';
+  bool changed = false;
+  if (lineTooLong) {
+    log.writeLine("Error: Command too long");
+  } else if (lineLength > 0) {
+    changed = execute(line);
+  }
+  lineLength = 0;
+  lineTooLong = false;
+  return changed;
+}
+
+// poll method implementation
+void TuningConsole::poll() {
+  if (unpublished) {
+    ModelBlob* buffer = slot.editBuffer();
+    if (buffer != NULL) {
+      // Same defuzzification as the running model, so only the edited sets or rules change
+      const ModelBlob* running = slot.current();
+      buildModelBlob(current, running != NULL && (running->flags & MODEL_BLOB_HAS_OUTPUT_TABLE), *buffer);
+      publish(buffer);
+      runningProfile = NO_PROFILE;
+    }
+  }
+
+  // Half the log buffer at most, so the regular records keep their room
+  while (listing != LIST_NONE && log.queuedRecords() < LogBuffer::SLOTS / 2) {
+    if (listing == LIST_METRICS) {
+      char text[MetricsRegistry::LINE_LENGTH + 1];
+      if (!metrics.formatLine(metricsCursor, text)) {
+        listing = LIST_NONE;
+        break;
+      }
+      log.writeLine(text);
+      continue;
+    }
+    if (listing == LIST_RULES) {
+      if (listPosition >= current.ruleCount) {
+        listing = LIST_NONE;
+        break;
+      }
+      printRule(listPosition++);
+      continue;
+    }
+    // Sets: position counts through the sets of every variable in turn
+    uint8_t position = listPosition++;
+    uint8_t variable = 0;
+    while (variable < MODEL_VARIABLES && position >= modelSetCount(variable)) {
+      position -= modelSetCount(variable++);
+    }
+    if (variable == MODEL_VARIABLES) {
+      listing = LIST_NONE;
+      break;
+    }
+    printSet(variable, position);
+  }
+}
+
+// noteFrame method implementation
+void TuningConsole::noteFrame(uint32_t modelVersion, unsigned long inferenceMicros) {
+  if (inferenceMicros == 0) {
+    return; // No inference in this frame (inputs not valid yet)
+  }
+  if (pendingVersion != 0 && modelVersion >= pendingVersion) {
+    char text[64];
+    char* p = appendText("Applied: inference ", text);
+    p = formatUnsigned(inferenceMicros, p);
+    p = appendText("us (was ", p);
+    p = formatUnsigned(beforeMicros, p);
+    appendText("us)", p);
+    log.writeLine(text);
+    pendingVersion = 0;
+  }
+  lastMicros = inferenceMicros;
+}
+
+// execute method implementation
+bool TuningConsole::execute(char* text) {
+  char* command = nextWord(text);
+  if (command == NULL) {
+    return false;
+  }
+  if (strcmp(command, "set") == 0) {
+    return commandSet(text);
+  }
+  if (strcmp(command, "rule") == 0) {
+    return commandRule(text);
+  }
+  if (strcmp(command, "sets") == 0) {
+    listing = LIST_SETS;
+    listPosition = 0;
+  } else if (strcmp(command, "rules") == 0) {
+    listing = LIST_RULES;
+    listPosition = 0;
+  } else if (strcmp(command, "metrics") == 0) {
+    listing = LIST_METRICS;
+    metricsCursor = MetricsRegistry::DumpCursor();
+  } else if (strcmp(command, "cost") == 0) {
+    printCost();
+  } else if (strcmp(command, "save") == 0) {
+    commandSave();
+  } else if (strcmp(command, "load") == 0) {
+    return commandLoad();
+  } else if (strcmp(command, "profile") == 0) {
+    return commandProfile(text);
+  } else if (strcmp(command, "profiles") == 0) {
+    printProfiles();
+  } else if (strcmp(command, "defaults") == 0) {
+    return selectProfile(0);
+  } else if (strcmp(command, "help") == 0) {
+    log.writeLine("sets | set <var>.<set> a b c d | rules | rule <n> <output set> | cost | metrics");
+    log.writeLine("save | load | profiles | profile <name> | defaults");
+  } else {
+    log.writeLine("Error: Unknown command (try help)");
+  }
+  return false;
+}
+
+// commandSet method implementation
+bool TuningConsole::commandSet(char* arguments) {
+  char* name = nextWord(arguments);
+  uint8_t variable, level;
+  if (name == NULL || !parseModelSet(name, variable, level)) {
+    log.writeLine("Error: Unknown set (e.g. temp.low, soil.dry, pump.full)");
+    return false;
+  }
+  SetPoints points;
+  if (!parseNumber(nextWord(arguments), points.a) || !parseNumber(nextWord(arguments), points.b) ||
+      !parseNumber(nextWord(arguments), points.c) || !parseNumber(nextWord(arguments), points.d) ||
+      nextWord(arguments) != NULL) {
+    log.writeLine("Error: Expected four points a b c d");
+    return false;
+  }
+  FuzzyModel candidate = current;
+  modelSet(candidate, variable, level) = points;
+  if (!accept(candidate)) {
+    return false;
+  }
+  printSet(variable, level);
+  return true;
+}
+
+// commandRule method implementation
+bool TuningConsole::commandRule(char* arguments) {
+  float number;
+  if (!parseNumber(nextWord(arguments), number) || number < 1 || number > current.ruleCount ||
+      number != (int)number) {
+    log.writeLine("Error: Unknown rule number");
+    return false;
+  }
+  uint8_t index = (uint8_t)number - 1;
+  char* name = nextWord(arguments);
+  uint8_t output;
+  if (name == NULL || !parseModelLevel(MODEL_OUTPUT, name, output) || nextWord(arguments) != NULL) {
+    log.writeLine("Error: Expected an output set (none, low, moderate, full)");
+    return false;
+  }
+  FuzzyModel candidate = current;
+  candidate.rules[index].output = output;
+  if (!accept(candidate)) {
+    return false;
+  }
+  printRule(index);
+  return true;
+}
+
+// commandSave method implementation
+void TuningConsole::commandSave() {
+  if (store == NULL) {
+    log.writeLine("Error: No model partition (FUZZY_MODEL_STORE)");
+    return;
+  }
+  const ModelBlob* mapped = (const ModelBlob*)store->map();
+  if (!unpublished && mapped != NULL && slot.current() == mapped) {
+    log.writeLine("Saved (the stored model is running)");
+    return;
+  }
+  // The blob is built in a free RAM buffer; the stored one is erased, so it must not be in use
+  ModelBlob* buffer = slot.editBuffer();
+  if (buffer == NULL || (mapped != NULL && slot.referenced(mapped))) {
+    log.writeLine("Error: Model in use by inference, try again");
+    return;
+  }
+  buildModelBlob(current, true, *buffer);
+  if (!storeModelBlob(*store, *buffer)) {
+    log.writeLine("Error: Writing the model partition failed");
+    return;
+  }
+  char text[32];
+  char* p = appendText("Saved (", text);
+  p = formatUnsigned(sizeof(ModelBlob), p);
+  appendText(" bytes)", p);
+  log.writeLine(text);
+}
+
+// commandLoad method implementation
+bool TuningConsole::commandLoad() {
+  const ModelBlob* blob = storedModel();
+  if (blob == NULL) {
+    log.writeLine("Error: No valid stored model");
+    return false;
+  }
+  current = blob->model;
+  publish(blob); // Also drops an edit still waiting for a buffer
+  runningProfile = NO_PROFILE;
+  log.writeLine("Loaded the stored model");
+  return true;
+}
+
+// commandProfile method implementation
+bool TuningConsole::commandProfile(char* arguments) {
+  char* name = nextWord(arguments);
+  if (name != NULL && nextWord(arguments) == NULL) {
+    for (uint8_t i = 0; i < profileCount; i++) {
+      if (strcmp(name, profiles[i].name) == 0) {
+        return selectProfile(i);
+      }
+    }
+  }
+  log.writeLine("Error: Unknown profile (try profiles)");
+  return false;
+}
+
+// printProfiles method implementation
+void TuningConsole::printProfiles() {
+  for (uint8_t i = 0; i < profileCount; i++) {
+    char text[40];
+    char* p = appendText(i == runningProfile ? "* " : "  ", text);
+    p = formatUnsigned(i, p);
+    p = appendText(" ", p);
+    appendText(profiles[i].name, p);
+    log.writeLine(text);
+  }
+}
+
+// accept method implementation
+bool TuningConsole::accept(const FuzzyModel& candidate) {
+  char error[MODEL_ERROR_LENGTH + 16];
+  char* p = appendText("Error: ", error);
+  if (!validateModel(candidate, p)) {
+    log.writeLine(error); // The running model stays as it was
+    return false;
+  }
+  current = candidate;
+  unpublished = true;
+  return true;
+}
+
+// publish method implementation
+void TuningConsole::publish(const ModelBlob* blob) {
+  slot.publish(blob);
+  unpublished = false;
+  if (pendingVersion == 0) {
+    beforeMicros = lastMicros; // Several quick changes are compared with the cost before the first
+  }
+  pendingVersion = slot.version();
+}
+
+// storedModel method implementation
+const ModelBlob* TuningConsole::storedModel() {
+  return store != NULL ? mapModelBlob(store->map(), store->size()) : NULL;
+}
+
+// printSet method implementation
+void TuningConsole::printSet(uint8_t variable, uint8_t level) {
+  const SetPoints& set = modelSet(current, variable, level);
+  const float points[4] = {set.a, set.b, set.c, set.d};
+  char text[64];
+  char* p = appendText(modelVariableName(variable), text);
+  p = appendText(".", p);
+  p = appendText(modelSetName(variable, level), p);
+  for (uint8_t i = 0; i < 4; i++) {
+    p = appendText(" ", p);
+    p = formatTenths(toTenths(points[i]), p);
+  }
+  log.writeLine(text);
+}
+
+// printRule method implementation
+void TuningConsole::printRule(uint8_t index) {
+  const RuleMapping& rule = current.rules[index];
+  char text[80];
+  char* p = appendText("rule ", text);
+  p = formatUnsigned(index + 1, p);
+  p = appendText(":", p);
+  for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+    if (rule.inputs[input] == RULE_ANY) continue;
+    p = appendText(" ", p);
+    p = appendText(modelVariableName(input), p);
+    p = appendText("=", p);
+    p = appendText(modelSetName(input, rule.inputs[input]), p);
+  }
+  p = appendText(" -> ", p);
+  appendText(modelSetName(MODEL_OUTPUT, rule.output), p);
+  log.writeLine(text);
+}
+
+// printCost method implementation
+void TuningConsole::printCost() {
+  char text[64];
+  char* p = appendText("Inference ", text);
+  p = formatUnsigned(lastMicros, p);
+  p = appendText("us, ", p);
+  p = formatUnsigned(current.ruleCount, p);
+  const ModelBlob* running = slot.current();
+  appendText((running->flags & MODEL_BLOB_HAS_OUTPUT_TABLE) ? " rules, output table" : " rules, exact centroid", p);
+  log.writeLine(text);
+}
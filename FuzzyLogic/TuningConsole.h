@@ -0,0 +1,123 @@
+// TuningConsole.h
+#ifndef TuningConsole_h // Include guard to prevent multiple inclusions
+#define TuningConsole_h
+
+#include <Arduino.h>
+#include "FuzzyModel.h"
+#include "ModelSlot.h"
+#include "FlashStore.h"
+#include "LogBuffer.h"
+#include "Metrics.h"
+
+// Serial command console for tuning the rule base while the controller runs.
+//
+//   help                      Lists the commands
+//   sets                      Prints every set's points ("soil.dry 0.0 0.0 20.0 35.0")
+//   set soil.dry 0 0 25 40    Moves the points of a set
+//   rules                     Prints every rule ("rule 5: temp=medium humid=low soil=dry -> full")
+//   rule 5 moderate           Maps a rule to another output set
+//   cost                      Prints the inference time of the last frame
+//   metrics                   Dumps the metrics registry (Prometheus text format)
+//   save                      Writes the model to the model partition (FUZZY_MODEL_STORE)
+//   load                      Runs the model stored there
+//   profiles                  Lists the compiled-in profiles, the running one marked with *
+//   profile tomato            Runs a profile
+//   defaults                  Runs the first profile (the sketch's built-in model)
+//
+// The console keeps its own copy of the model. An edit is made on a copy of that and
+// checked with validateModel(); a rejected edit changes nothing. An accepted one is built
+// into a ModelBlob in one of the slot's RAM buffers, with an output table only if the
+// running model has one, and swapped in (the console is the slot's only writer), so it takes effect at the next inference; edits made while both
+// buffers are still in use are combined into the next swap. "load" and "profile" swap in
+// the stored blob or the profile's blob where it is, without a copy: constant time
+// whatever the model. Once a frame shows the new
+// model version, the console reports its inference time next to the one before the change.
+//
+// Replies are queued in the LogBuffer like every other log line, so the console never
+// blocks. The longer listings (sets, rules, metrics) are queued a few lines per poll() while the
+// buffer has room, so they don't push other records out. Runs on the rendering side
+// (where Serial is read and written); "save" blocks it while the sector is erased.
+class TuningConsole {
+  public:
+    static const uint8_t LINE_LENGTH = 64; // Longest command; longer lines are rejected
+    static const uint8_t NO_PROFILE = 0xFF;
+
+    TuningConsole(ModelSlot& slot, LogBuffer& log, const MetricsRegistry& metrics);
+
+    // Publishes the model inference starts with: the one in store if it holds a valid blob,
+    // otherwise the first profile. profiles is a constant table (at least one entry) whose
+    // blobs stay in place. store may be NULL.
+    void begin(const ModelProfile* profiles, uint8_t profileCount, FlashStore* store);
+
+    // Swaps in a profile (for the pins and schedule of ProfileSelector; the same as the
+    // "profile" command). False if there is no such profile.
+    bool selectProfile(uint8_t index);
+
+    // Feeds one received character; a command runs at the end of its line (CR or LF).
+    // Returns true if the command changed the model.
+    bool feed(char c);
+
+    // Swaps in an accepted edit and continues a listing in progress. Call often (next to
+    // LogBuffer::drain()).
+    void poll();
+
+    // Tells the console the model version and inference time of a rendered frame.
+    void noteFrame(uint32_t modelVersion, unsigned long inferenceMicros);
+
+    // The console's (latest accepted) model.
+    const FuzzyModel& model() const { return current; }
+
+  private:
+    // Runs one command line (split in place). True if the model changed.
+    bool execute(char* line);
+
+    bool commandSet(char* arguments);
+    bool commandRule(char* arguments);
+    void commandSave();
+    bool commandLoad();
+    bool commandProfile(char* arguments);
+    void printProfiles();
+    void printCost();
+    void printSet(uint8_t variable, uint8_t level);
+    void printRule(uint8_t index);
+
+    // Validates candidate and makes it the console's model, to be swapped in by poll().
+    // Reports the problem and returns false if the model is rejected.
+    bool accept(const FuzzyModel& candidate);
+
+    // Swaps blob in and starts timing the change
+    void publish(const ModelBlob* blob);
+
+    // The valid blob in the model partition, NULL if there is none
+    const ModelBlob* storedModel();
+
+    ModelSlot& slot;
+    LogBuffer& log;
+    const MetricsRegistry& metrics;
+    const ModelProfile* profiles;
+    uint8_t profileCount;
+    uint8_t runningProfile; // Profile in use, NO_PROFILE after an edit or a load
+    FlashStore* store;
+    FuzzyModel current;
+    bool unpublished; // current has an accepted edit that is not swapped in yet
+
+    enum Listing {
+      LIST_NONE,
+      LIST_SETS,
+      LIST_RULES,
+      LIST_METRICS
+    };
+    Listing listing;
+    uint8_t listPosition; // Next set (all variables in order) or rule to print
+    MetricsRegistry::DumpCursor metricsCursor;
+
+    char line[LINE_LENGTH + 1];
+    uint8_t lineLength;
+    bool lineTooLong;
+
+    uint32_t pendingVersion;    // Version whose cost is still to be reported (0 = none)
+    unsigned long lastMicros;   // Inference time of the last frame
+    unsigned long beforeMicros; // ... of the last frame before the pending change
+};
+
+#endif // End of include guard
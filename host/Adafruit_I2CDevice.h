@@ -0,0 +1,2 @@
+// Adafruit_I2CDevice.h (host build)
+// Included by Adafruit_GFX.h for its bus helpers, which the sketch doesn't use.
@@ -0,0 +1,2 @@
+// Adafruit_SPIDevice.h (host build)
+// Included by Adafruit_GFX.h for its bus helpers, which the sketch doesn't use.
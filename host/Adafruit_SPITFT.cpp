@@ -0,0 +1,282 @@
+// Adafruit_SPITFT.cpp (host build)
+#include "Adafruit_SPITFT.h"
+#include "Adafruit_ST77xx.h"
+#include <stdio.h>
+
+static Adafruit_SPITFT* instance = NULL; // Panel created last
+
+// ST7735 scroll commands (not defined by the library)
+static const uint8_t ST7735_VSCRDEF = 0x33;
+static const uint8_t ST7735_VSCSAD = 0x37;
+
+// Constructor implementation
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst) :
+  Adafruit_GFX(w, h),
+  _cs(cs),
+  _dc(dc),
+  _rst(rst),
+  ram(new uint16_t[RAM_SIZE * RAM_SIZE]()), // Power-on RAM: black
+  windowX0(0), windowX1(0), windowY0(0), windowY1(0),
+  writeX(0), writeY(0),
+  lastCommand(0),
+  scrollTop(0), scrollLines(0), scrollStart(0),
+  scrollDefined(false),
+  counted({0, 0, 0, 0}) {
+  instance = this;
+}
+
+// Destructor implementation
+Adafruit_SPITFT::~Adafruit_SPITFT() {
+  if (instance == this) {
+    instance = NULL;
+  }
+  delete[] ram;
+}
+
+// mockInstance method implementation
+Adafruit_SPITFT* Adafruit_SPITFT::mockInstance() {
+  return instance;
+}
+
+// resetTraffic method implementation
+void Adafruit_SPITFT::resetTraffic() {
+  counted = {0, 0, 0, 0};
+}
+
+// startWrite method implementation
+void Adafruit_SPITFT::startWrite() {
+  // Chip select and SPI transactions carry no state on the host
+}
+
+// endWrite method implementation
+void Adafruit_SPITFT::endWrite() {
+}
+
+// drawPixel method implementation
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  writePixel(x, y, color);
+}
+
+// writePixel method implementation
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) {
+    return; // Clipped: nothing is sent
+  }
+  setAddrWindow(x, y, 1, 1);
+  writeColor(color, 1);
+}
+
+// fillRect method implementation
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  writeFillRect(x, y, w, h, color);
+}
+
+// writeFillRect method implementation
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  // Same clipping as the library: negative sizes flip the origin, then clip to the screen
+  if (w < 0) { x += w + 1; w = -w; }
+  if (h < 0) { y += h + 1; h = -h; }
+  int16_t x1 = min((int16_t)(x + w), _width);
+  int16_t y1 = min((int16_t)(y + h), _height);
+  x = max(x, (int16_t)0);
+  y = max(y, (int16_t)0);
+  if (x >= x1 || y >= y1) {
+    return;
+  }
+  setAddrWindow(x, y, x1 - x, y1 - y);
+  writeColor(color, (uint32_t)(x1 - x) * (y1 - y));
+}
+
+// drawFastHLine method implementation
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  writeFillRect(x, y, w, 1, color);
+}
+
+// writeFastHLine method implementation
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  writeFillRect(x, y, w, 1, color);
+}
+
+// drawFastVLine method implementation
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  writeFillRect(x, y, 1, h, color);
+}
+
+// writeFastVLine method implementation
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  writeFillRect(x, y, 1, h, color);
+}
+
+// drawRGBBitmap method implementation
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h) {
+  // Clipped like the library: the visible part goes out as one window, row by row
+  int16_t x1 = min((int16_t)(x + w), _width);
+  int16_t y1 = min((int16_t)(y + h), _height);
+  int16_t bx = x < 0 ? -x : 0;
+  int16_t by = y < 0 ? -y : 0;
+  x = max(x, (int16_t)0);
+  y = max(y, (int16_t)0);
+  if (x >= x1 || y >= y1) {
+    return;
+  }
+  setAddrWindow(x, y, x1 - x, y1 - y);
+  for (int16_t row = by; row < by + (y1 - y); row++) {
+    writePixels(&pcolors[row * w + bx], x1 - x);
+  }
+}
+
+// writePixels method implementation
+void Adafruit_SPITFT::writePixels(uint16_t* colors, uint32_t len, bool /*block*/, bool bigEndian) {
+  for (uint32_t i = 0; i < len; i++) {
+    uint16_t color = bigEndian ? (uint16_t)((colors[i] >> 8) | (colors[i] << 8)) : colors[i];
+    ramWrite(color);
+  }
+  counted.pixels += len;
+  counted.bytes += len * 2;
+}
+
+// writeColor method implementation
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+  for (uint32_t i = 0; i < len; i++) {
+    ramWrite(color);
+  }
+  counted.pixels += len;
+  counted.bytes += len * 2;
+}
+
+// pushColor method implementation
+void Adafruit_SPITFT::pushColor(uint16_t color) {
+  writeColor(color, 1);
+}
+
+// sendCommand method implementation
+void Adafruit_SPITFT::sendCommand(uint8_t commandByte, const uint8_t* dataBytes, uint8_t numDataBytes) {
+  writeCommandBytes(commandByte, dataBytes, numDataBytes);
+}
+
+// writeCommandBytes method implementation
+void Adafruit_SPITFT::writeCommandBytes(uint8_t commandByte, const uint8_t* dataBytes, uint8_t numDataBytes) {
+  counted.commands++;
+  counted.bytes += 1 + numDataBytes;
+  lastCommand = commandByte;
+
+  switch (commandByte) {
+    case ST77XX_CASET: // Column window, big-endian start/end
+      counted.addressWindows++;
+      if (numDataBytes >= 4) {
+        windowX0 = (dataBytes[0] << 8) | dataBytes[1];
+        windowX1 = (dataBytes[2] << 8) | dataBytes[3];
+      }
+      break;
+    case ST77XX_RASET: // Row window
+      if (numDataBytes >= 4) {
+        windowY0 = (dataBytes[0] << 8) | dataBytes[1];
+        windowY1 = (dataBytes[2] << 8) | dataBytes[3];
+      }
+      break;
+    case ST77XX_RAMWR: // Pixel data follows from the window's top left corner
+      writeX = windowX0;
+      writeY = windowY0;
+      break;
+    case ST7735_VSCRDEF: // Top fixed area, scroll area, bottom fixed area
+      if (numDataBytes >= 6) {
+        scrollTop = (dataBytes[0] << 8) | dataBytes[1];
+        scrollLines = (dataBytes[2] << 8) | dataBytes[3];
+        scrollDefined = scrollLines > 0;
+      }
+      break;
+    case ST7735_VSCSAD: // Line shown at the top of the scroll area
+      if (numDataBytes >= 2) {
+        scrollStart = (dataBytes[0] << 8) | dataBytes[1];
+      }
+      break;
+    default:
+      break; // Init, MADCTL and power commands don't change the image model
+  }
+}
+
+// ramWrite method implementation
+void Adafruit_SPITFT::ramWrite(uint16_t color) {
+  if (lastCommand != ST77XX_RAMWR) {
+    return; // Pixel data without RAMWR is ignored by the controller
+  }
+  if (writeX < RAM_SIZE && writeY < RAM_SIZE) {
+    ram[writeY * RAM_SIZE + writeX] = color;
+  }
+  // Advance inside the window, wrapping to the next row like the controller does
+  if (++writeX > windowX1) {
+    writeX = windowX0;
+    if (++writeY > windowY1) {
+      writeY = windowY0;
+    }
+  }
+}
+
+// visiblePixel method implementation
+uint16_t Adafruit_SPITFT::visiblePixel(int16_t x, int16_t y) const {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) {
+    return 0;
+  }
+  int16_t line = x + _xstart; // RAM line along x in rotation 3
+  if (scrollDefined && rotation == 3 && line >= scrollTop && line < scrollTop + scrollLines) {
+    // Display line 'line' shows the RAM line (scrollStart - scrollTop) lines further,
+    // wrapping inside the scroll area
+    int32_t shifted = ((int32_t)line - scrollTop + (int32_t)scrollStart - scrollTop) % scrollLines;
+    line = scrollTop + (shifted < 0 ? shifted + scrollLines : shifted);
+  }
+  return ram[(y + _ystart) * RAM_SIZE + line];
+}
+
+// writePpm method implementation
+bool Adafruit_SPITFT::writePpm(const char* path) const {
+  FILE* file = fopen(path, "wb");
+  if (file == NULL) {
+    return false;
+  }
+  fprintf(file, "P6\n%d %d\n255\n", _width, _height);
+  for (int16_t y = 0; y < _height; y++) {
+    for (int16_t x = 0; x < _width; x++) {
+      uint16_t c = visiblePixel(x, y);
+      // Expand RGB565 to RGB888, replicating the high bits into the low ones
+      uint8_t rgb[3] = {
+        (uint8_t)(((c >> 11) & 0x1F) << 3 | ((c >> 11) & 0x1F) >> 2),
+        (uint8_t)(((c >> 5) & 0x3F) << 2 | ((c >> 5) & 0x3F) >> 4),
+        (uint8_t)((c & 0x1F) << 3 | (c & 0x1F) >> 2)
+      };
+      fwrite(rgb, 1, 3, file);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+// comparePpm method implementation
+int32_t Adafruit_SPITFT::comparePpm(const char* path) const {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return -1;
+  }
+  int width = 0, height = 0, maxValue = 0;
+  if (fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) != 3 || maxValue != 255 ||
+      width != _width || height != _height) {
+    fclose(file);
+    return -1;
+  }
+  fgetc(file); // Single whitespace after the header
+
+  int32_t differences = 0;
+  for (int16_t y = 0; y < _height; y++) {
+    for (int16_t x = 0; x < _width; x++) {
+      uint8_t rgb[3];
+      if (fread(rgb, 1, 3, file) != 3) {
+        fclose(file);
+        return -1;
+      }
+      uint16_t expected = color565(rgb[0], rgb[1], rgb[2]);
+      if (expected != visiblePixel(x, y)) {
+        differences++;
+      }
+    }
+  }
+  fclose(file);
+  return differences;
+}
@@ -0,0 +1,103 @@
+// Adafruit_SPITFT.h (host build)
+#ifndef _ADAFRUIT_SPITFT_H_ // Same guard as the library, so only one of the two is ever used
+#define _ADAFRUIT_SPITFT_H_
+
+#include <Adafruit_GFX.h>
+
+// Traffic a real SPI panel would have seen, counted like the library sends it.
+struct PanelTraffic {
+  uint32_t commands;       // Command bytes (D/C low), including CASET/RASET/RAMWR
+  uint32_t addressWindows; // Address windows opened (CASET): one per rectangle / pixel / bitmap
+  uint32_t pixels;         // RGB565 pixels written to panel RAM
+  uint32_t bytes;          // Everything on MOSI: commands, their parameters and pixel data
+};
+
+// Host stand-in for Adafruit_SPITFT: same drawing API, but every write goes to an
+// in-memory RGB565 image of the panel instead of SPI, and the bytes the library would
+// have clocked out are counted. Drawing calls map to SPI traffic the way the library does
+// it: fills and bitmaps open one address window and stream pixels, a single pixel (and
+// so every pixel of Adafruit_GFX's built-in text) costs an address window of its own.
+//
+// The host-only part (traffic counters, image access, PPM files) is at the end of the
+// public section. Hardware scroll is emulated for rotation 3, where the ST7735's scroll
+// lines run along x (the only rotation FuzzyDisplay scrolls in).
+class Adafruit_SPITFT : public Adafruit_GFX {
+  public:
+    Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst = -1);
+    ~Adafruit_SPITFT();
+
+    virtual void begin(uint32_t freq) = 0;
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+
+    // Drawing API used by the sketch (and by Adafruit_GFX for text and shapes)
+    void startWrite() override;
+    void endWrite() override;
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h);
+    void writePixels(uint16_t* colors, uint32_t len, bool block = true, bool bigEndian = false);
+    void writeColor(uint16_t color, uint32_t len);
+    void pushColor(uint16_t color);
+    void sendCommand(uint8_t commandByte, const uint8_t* dataBytes = NULL, uint8_t numDataBytes = 0);
+    void sendCommand(uint8_t commandByte, uint8_t* dataBytes, uint8_t numDataBytes) {
+      sendCommand(commandByte, (const uint8_t*)dataBytes, numDataBytes);
+    }
+    uint16_t color565(uint8_t red, uint8_t green, uint8_t blue) const {
+      return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+    }
+
+    // --- Host-only API ---
+
+    // Panel created last (the one inside FuzzyDisplay), or NULL.
+    static Adafruit_SPITFT* mockInstance();
+
+    // Traffic counted since the last resetTraffic().
+    const PanelTraffic& traffic() const { return counted; }
+    void resetTraffic();
+
+    // Color of the pixel visible at (x, y) of the current rotation, after hardware scroll.
+    uint16_t visiblePixel(int16_t x, int16_t y) const;
+
+    // Writes the visible image as a binary PPM (P6). Returns false if the file can't be written.
+    bool writePpm(const char* path) const;
+
+    // Number of pixels that differ from a PPM written by writePpm(), compared in RGB565.
+    // Returns -1 if the file is missing or has another size.
+    int32_t comparePpm(const char* path) const;
+
+  protected:
+    // Controller-side handling of a command and its parameters (CASET, RASET, RAMWR,
+    // MADCTL, VSCRDEF, VSCSAD); Adafruit_ST77xx sends everything through here.
+    void writeCommandBytes(uint8_t commandByte, const uint8_t* dataBytes, uint8_t numDataBytes);
+
+    // Stores one pixel at the RAM write position and advances it inside the window.
+    void ramWrite(uint16_t color);
+
+    int8_t _cs, _dc, _rst;        // Pins as given (unused on the host)
+    int16_t _xstart = 0;          // Column offset added by setAddrWindow() (rotation-dependent)
+    int16_t _ystart = 0;          // Row offset added by setAddrWindow()
+
+  private:
+    // Panel RAM in the current rotation's orientation, indexed by [y + _ystart][x + _xstart].
+    static const int16_t RAM_SIZE = 162;   // Covers 132x162 in both orientations
+    uint16_t* ram;
+
+    // Current RAMWR window (RAM coordinates) and write position
+    uint16_t windowX0, windowX1, windowY0, windowY1;
+    uint16_t writeX, writeY;
+    uint8_t lastCommand;
+
+    // Vertical scroll (VSCRDEF / VSCSAD), in RAM lines
+    uint16_t scrollTop, scrollLines, scrollStart;
+    bool scrollDefined;
+
+    PanelTraffic counted;
+};
+
+#endif // End of include guard
@@ -0,0 +1,117 @@
+// Adafruit_ST7735.cpp (host build)
+#include "Adafruit_ST7735.h"
+
+// Reduced init sequence in the library's command list format (delays are not simulated)
+static const uint8_t hostInitCommands[] = {
+  5,                              // 5 commands:
+  ST77XX_SWRESET, 0x80, 150,      //  Software reset, then delay
+  ST77XX_SLPOUT, 0x80, 255,       //  Out of sleep mode, then delay
+  ST77XX_COLMOD, 1, 0x05,         //  16-bit color
+  ST77XX_NORON, 0x80, 10,         //  Normal display on
+  ST77XX_DISPON, 0x80, 100        //  Main screen turn on
+};
+
+// Adafruit_ST77xx constructor implementation
+Adafruit_ST77xx::Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst) :
+  Adafruit_SPITFT(w, h, cs, dc, rst) {
+}
+
+// Adafruit_ST77xx begin method implementation
+void Adafruit_ST77xx::begin(uint32_t /*freq*/) {
+  // The SPI clock doesn't matter to the image or the byte counts
+}
+
+// Adafruit_ST77xx displayInit method implementation
+void Adafruit_ST77xx::displayInit(const uint8_t* addr) {
+  uint8_t numCommands = *addr++;
+  while (numCommands--) {
+    uint8_t command = *addr++;
+    uint8_t numArgs = *addr++;
+    bool hasDelay = numArgs & 0x80;
+    numArgs &= 0x7F;
+    writeCommandBytes(command, addr, numArgs);
+    addr += numArgs;
+    if (hasDelay) {
+      addr++; // Delay byte: not simulated
+    }
+  }
+}
+
+// Adafruit_ST77xx setColRowStart method implementation
+void Adafruit_ST77xx::setColRowStart(int8_t col, int8_t row) {
+  _colstart = col;
+  _rowstart = row;
+}
+
+// Adafruit_ST77xx setAddrWindow method implementation
+void Adafruit_ST77xx::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  x += _xstart;
+  y += _ystart;
+  uint16_t x1 = x + w - 1;
+  uint16_t y1 = y + h - 1;
+  uint8_t columns[4] = {(uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(x1 >> 8), (uint8_t)x1};
+  uint8_t rows[4] = {(uint8_t)(y >> 8), (uint8_t)y, (uint8_t)(y1 >> 8), (uint8_t)y1};
+  writeCommandBytes(ST77XX_CASET, columns, 4); // Column addr set
+  writeCommandBytes(ST77XX_RASET, rows, 4);    // Row addr set
+  writeCommandBytes(ST77XX_RAMWR, NULL, 0);    // Write to RAM
+}
+
+// Adafruit_ST77xx setRotation method implementation
+void Adafruit_ST77xx::setRotation(uint8_t m) {
+  uint8_t madctl = 0;
+  rotation = m & 3;
+  switch (rotation) {
+    case 0:
+      madctl = ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_RGB;
+      _xstart = _colstart;
+      _ystart = _rowstart;
+      break;
+    case 1:
+      madctl = ST77XX_MADCTL_MY | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB;
+      _ystart = _colstart;
+      _xstart = _rowstart;
+      break;
+    case 2:
+      madctl = ST77XX_MADCTL_RGB;
+      _xstart = _colstart;
+      _ystart = _rowstart;
+      break;
+    case 3:
+      madctl = ST77XX_MADCTL_MX | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB;
+      _ystart = _colstart;
+      _xstart = _rowstart;
+      break;
+  }
+  _width = (rotation & 1) ? HEIGHT : WIDTH;
+  _height = (rotation & 1) ? WIDTH : HEIGHT;
+  writeCommandBytes(ST77XX_MADCTL, &madctl, 1);
+}
+
+// Adafruit_ST77xx enableDisplay method implementation
+void Adafruit_ST77xx::enableDisplay(bool enable) {
+  writeCommandBytes(enable ? ST77XX_DISPON : ST77XX_DISPOFF, NULL, 0);
+}
+
+// Constructor implementation
+Adafruit_ST7735::Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst) :
+  Adafruit_ST77xx(ST7735_TFTWIDTH_128, ST7735_TFTHEIGHT_160, cs, dc, rst),
+  tabcolor(0) {
+}
+
+// initB method implementation
+void Adafruit_ST7735::initB() {
+  displayInit(hostInitCommands);
+  setRotation(0);
+}
+
+// initR method implementation
+void Adafruit_ST7735::initR(uint8_t options) {
+  displayInit(hostInitCommands);
+  if (options == INITR_GREENTAB) {
+    setColRowStart(2, 1); // Green tab panels start at RAM column 2, row 1
+  } else {
+    setColRowStart(0, 0);
+  }
+  tabcolor = options;
+  setRotation(0);
+}
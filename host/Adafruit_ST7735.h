@@ -0,0 +1,45 @@
+// Adafruit_ST7735.h (host build)
+#ifndef _ADAFRUIT_ST7735H_ // Same guard as the library
+#define _ADAFRUIT_ST7735H_
+
+#include "Adafruit_ST77xx.h"
+
+// Tab options of initR(), with the library's values
+#define INITR_GREENTAB 0x00
+#define INITR_REDTAB 0x01
+#define INITR_BLACKTAB 0x02
+#define INITR_18GREENTAB INITR_GREENTAB
+#define INITR_18REDTAB INITR_REDTAB
+#define INITR_18BLACKTAB INITR_BLACKTAB
+#define INITR_144GREENTAB 0x01
+#define INITR_MINI160x80 0x04
+#define INITR_HALLOWING 0x05
+
+#define ST7735_TFTWIDTH_128 128
+#define ST7735_TFTHEIGHT_160 160
+
+#define ST7735_BLACK ST77XX_BLACK
+#define ST7735_WHITE ST77XX_WHITE
+#define ST7735_RED ST77XX_RED
+#define ST7735_GREEN ST77XX_GREEN
+#define ST7735_BLUE ST77XX_BLUE
+#define ST7735_CYAN ST77XX_CYAN
+#define ST7735_MAGENTA ST77XX_MAGENTA
+#define ST7735_YELLOW ST77XX_YELLOW
+#define ST7735_ORANGE ST77XX_ORANGE
+
+// Host stand-in for Adafruit_ST7735 (1.8" 128x160 panels). initR() applies the RAM
+// offsets of the green, red and black tab panels, and setRotation() the same MADCTL and
+// offset handling as the library; the init command list is reduced to a few commands.
+class Adafruit_ST7735 : public Adafruit_ST77xx {
+  public:
+    Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst);
+
+    void initB();
+    void initR(uint8_t options = INITR_GREENTAB);
+
+  private:
+    uint8_t tabcolor;
+};
+
+#endif // End of include guard
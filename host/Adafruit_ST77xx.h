@@ -0,0 +1,58 @@
+// Adafruit_ST77xx.h (host build)
+#ifndef _ADAFRUIT_ST77XXH_ // Same guard as the library
+#define _ADAFRUIT_ST77XXH_
+
+#include "Adafruit_SPITFT.h"
+
+// Commands and colors used by the sketch, with the library's names and values
+#define ST77XX_NOP 0x00
+#define ST77XX_SWRESET 0x01
+#define ST77XX_SLPOUT 0x11
+#define ST77XX_NORON 0x13
+#define ST77XX_INVOFF 0x20
+#define ST77XX_INVON 0x21
+#define ST77XX_DISPOFF 0x28
+#define ST77XX_DISPON 0x29
+#define ST77XX_CASET 0x2A
+#define ST77XX_RASET 0x2B
+#define ST77XX_RAMWR 0x2C
+#define ST77XX_MADCTL 0x36
+#define ST77XX_COLMOD 0x3A
+
+#define ST77XX_MADCTL_MY 0x80
+#define ST77XX_MADCTL_MX 0x40
+#define ST77XX_MADCTL_MV 0x20
+#define ST77XX_MADCTL_ML 0x10
+#define ST77XX_MADCTL_RGB 0x00
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+// Host stand-in for Adafruit_ST77xx: address windows with the panel's RAM offsets.
+class Adafruit_ST77xx : public Adafruit_SPITFT {
+  public:
+    Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst = -1);
+
+    void begin(uint32_t freq = 0) override;
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+    void setRotation(uint8_t r) override;
+    void enableDisplay(bool enable);
+
+  protected:
+    // Sends an init command list in the library's format: count, then per command
+    // the command byte, parameter count (bit 7: delay follows), parameters, delay.
+    void displayInit(const uint8_t* addr);
+    void setColRowStart(int8_t col, int8_t row);
+
+    uint8_t _colstart = 0;   // Panel RAM column of screen x = 0 in rotation 0
+    uint8_t _rowstart = 0;   // Panel RAM row of screen y = 0 in rotation 0
+};
+
+#endif // End of include guard
@@ -0,0 +1,117 @@
+// Arduino.h (host build)
+#ifndef Arduino_h // Include guard to prevent multiple inclusions
+#define Arduino_h
+
+// Minimal Arduino API for building the sketch's hardware-independent modules on Linux.
+// Time, pins, ADC, PWM and interrupts are simulated by MockHal.cpp; see MockHal.h for the
+// functions a host program uses to drive the simulation.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#define ARDUINO 10819 // Libraries built against the shim (Adafruit_GFX) check for >= 100
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define IRAM_ATTR
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define digitalPinToInterrupt(p) (p)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+using std::isnan;
+using std::min; // As on arduino-esp32
+using std::max;
+
+char* itoa(int value, char* str, int base);
+char* ltoa(long value, char* str, int base);
+
+// Flash strings are ordinary strings on the host; only declared for library signatures.
+class __FlashStringHelper;
+
+// Minimal Arduino String, enough for library signatures that take one.
+class String {
+  public:
+    String(const char* str = "") : text(str) {}
+    unsigned int length() const { return text.length(); }
+    const char* c_str() const { return text.c_str(); }
+  private:
+    std::string text;
+};
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+// LEDC PWM as in arduino-esp32 3.x (the duty cycle is recorded, see MockHal.h)
+bool ledcAttach(uint8_t pin, uint32_t frequency, uint8_t resolutionBits);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+// Subset of Arduino's Print: the same number formatting, output goes to write().
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    virtual int availableForWrite() { return 0; }
+
+    size_t print(const char* str);
+    size_t print(char c);
+    size_t print(unsigned long n, int base = 10);
+    size_t print(long n, int base = 10);
+    size_t print(unsigned int n, int base = 10) { return print((unsigned long)n, base); }
+    size_t print(int n, int base = 10) { return print((long)n, base); }
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+// Serial: writes to stdout, reads from stdin (non-blocking).
+class HostSerial : public Print {
+  public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override { return 4096; }
+    int available();
+    int read();
+    void flush();
+    operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+#endif // End of include guard
@@ -0,0 +1,65 @@
+// FileFlash.cpp
+#include "FileFlash.h" // Include the header file we just defined
+#include <stdio.h>
+
+// Constructor implementation
+FileFlash::FileFlash(const char* path, uint32_t defaultSize) :
+  path(path),
+  open(false),
+  writes(0) {
+  FILE* file = fopen(path, "rb");
+  if (file) {
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    image.resize(length > 0 ? (size_t)length / sectorSize() * sectorSize() : 0);
+    open = fread(image.data(), 1, image.size(), file) == image.size();
+    fclose(file);
+  } else {
+    image.assign(defaultSize / sectorSize() * sectorSize(), 0xFF); // Fresh, fully erased chip
+    open = true;
+  }
+  erases.assign(image.size() / sectorSize(), 0);
+}
+
+// save method implementation
+bool FileFlash::save() {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  bool ok = fwrite(image.data(), 1, image.size(), file) == image.size();
+  return fclose(file) == 0 && ok;
+}
+
+// read method implementation
+bool FileFlash::read(uint32_t address, void* data, size_t length) {
+  if (address + length > image.size()) {
+    return false;
+  }
+  memcpy(data, image.data() + address, length);
+  return true;
+}
+
+// write method implementation
+bool FileFlash::write(uint32_t address, const void* data, size_t length) {
+  if (address + length > image.size()) {
+    return false;
+  }
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < length; i++) {
+    image[address + i] &= bytes[i]; // Programming only clears bits
+  }
+  writes++;
+  return true;
+}
+
+// eraseSector method implementation
+bool FileFlash::eraseSector(uint32_t address) {
+  if (address % sectorSize() != 0 || address >= image.size()) {
+    return false;
+  }
+  memset(image.data() + address, 0xFF, sectorSize());
+  erases[address / sectorSize()]++;
+  return true;
+}
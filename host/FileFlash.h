@@ -0,0 +1,43 @@
+// FileFlash.h
+#ifndef FileFlash_h // Include guard to prevent multiple inclusions
+#define FileFlash_h
+
+#include <vector>
+#include "FlashStore.h"
+
+// FlashStore emulated in RAM and backed by an image file (host build).
+// Keeps the NOR rules of the real chip: writes can only clear bits (the image is ANDed
+// with the new data, so writing over unerased data shows up as corruption, as it would
+// on the device) and erasing sets a sector to 0xFF. Counts erases per sector.
+// The image has the same layout as the partition, so a dump of the device partition
+// (esptool.py read_flash) can be opened directly.
+class FileFlash : public FlashStore {
+  public:
+    // Opens path, or creates an erased image of defaultSize bytes if it doesn't exist.
+    FileFlash(const char* path, uint32_t defaultSize);
+
+    // True if the image could be read or created.
+    bool isOpen() const { return open; }
+
+    // Writes the image back to the file.
+    bool save();
+
+    uint32_t size() const override { return image.size(); }
+    bool read(uint32_t address, void* data, size_t length) override;
+    bool write(uint32_t address, const void* data, size_t length) override;
+    bool eraseSector(uint32_t address) override;
+    const void* map() override { return image.data(); }
+
+    // Erases of one sector in this session, and write calls so far.
+    uint32_t sectorErases(uint32_t sector) const { return sector < erases.size() ? erases[sector] : 0; }
+    uint32_t writeCalls() const { return writes; }
+
+  private:
+    const char* path;
+    bool open;
+    std::vector<uint8_t> image;
+    std::vector<uint32_t> erases;
+    uint32_t writes;
+};
+
+#endif // End of include guard
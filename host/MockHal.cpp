@@ -0,0 +1,259 @@
+// MockHal.cpp
+#include "MockHal.h" // Include the header file we just defined
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+HostSerial Serial;
+
+static const uint8_t MOCK_PINS = 40;      // ESP32 GPIO count
+static const uint8_t MAX_EVENTS = 64;     // Pending falling edges (one DHT response is 42)
+
+static unsigned long long nowMicros = 0;
+static uint8_t pinModes[MOCK_PINS];
+static uint8_t pinLevels[MOCK_PINS];
+static int analogValues[MOCK_PINS];
+static void (*interruptHandlers[MOCK_PINS])();
+static int interruptModes[MOCK_PINS];
+
+// Simulated LEDC PWM
+static uint8_t pwmBits[MOCK_PINS];      // Resolution, 0 = not attached
+static uint32_t pwmDuty[MOCK_PINS];
+static uint32_t pwmWrites[MOCK_PINS];
+static unsigned long long pwmWriteMicros[MOCK_PINS];
+
+// Scheduled falling edges (from the simulated DHT22), sorted by time.
+static unsigned long long eventMicros[MAX_EVENTS];
+static uint8_t eventPins[MAX_EVENTS];
+static uint8_t eventCount = 0;
+
+// Simulated DHT22
+static int dhtPin = -1;
+static float dhtTemperature = 0;
+static float dhtHumidity = 0;
+static unsigned long long dhtLowSince = 0; // When the host started the start pulse
+
+static void scheduleFallingEdge(unsigned long long at, uint8_t pin) {
+  if (eventCount < MAX_EVENTS) {
+    eventMicros[eventCount] = at;
+    eventPins[eventCount] = pin;
+    eventCount++;
+  }
+}
+
+static void scheduleDhtResponse(unsigned long long start) {
+  uint16_t humid = (uint16_t)lround(dhtHumidity * 10);
+  uint16_t temp = (uint16_t)lround(fabs(dhtTemperature) * 10);
+  if (dhtTemperature < 0) temp |= 0x8000;
+  uint8_t data[5] = {(uint8_t)(humid >> 8), (uint8_t)humid, (uint8_t)(temp >> 8), (uint8_t)temp, 0};
+  data[4] = data[0] + data[1] + data[2] + data[3];
+
+  unsigned long long t = start + 30;  // Sensor pulls low 20-40 us after release
+  scheduleFallingEdge(t, dhtPin);
+  t += 80 + 80;                       // 80 us low + 80 us high, then bit 0 starts low
+  scheduleFallingEdge(t, dhtPin);
+  for (uint8_t i = 0; i < 40; i++) {
+    bool one = data[i / 8] & (0x80 >> (i % 8));
+    t += 50 + (one ? 70 : 27);        // 50 us low, then 26-28 us (0) or 70 us (1) high
+    scheduleFallingEdge(t, dhtPin);
+  }
+}
+
+// --- Simulation control ---
+
+void mockAdvanceMicros(unsigned long us) {
+  unsigned long long target = nowMicros + us;
+  while (eventCount > 0 && eventMicros[0] <= target) {
+    nowMicros = eventMicros[0];
+    uint8_t pin = eventPins[0];
+    memmove(eventMicros, eventMicros + 1, (eventCount - 1) * sizeof(eventMicros[0]));
+    memmove(eventPins, eventPins + 1, (eventCount - 1) * sizeof(eventPins[0]));
+    eventCount--;
+    if (interruptHandlers[pin] != NULL && (interruptModes[pin] == FALLING || interruptModes[pin] == CHANGE)) {
+      interruptHandlers[pin]();
+    }
+  }
+  nowMicros = target;
+}
+
+void mockSetAnalog(uint8_t pin, int value) {
+  if (pin < MOCK_PINS) analogValues[pin] = value;
+}
+
+void mockAttachDht22(uint8_t pin, float temperature, float humidity) {
+  dhtPin = pin;
+  mockSetDht22(temperature, humidity);
+}
+
+void mockSetDht22(float temperature, float humidity) {
+  dhtTemperature = temperature;
+  dhtHumidity = humidity;
+}
+
+uint8_t mockPinLevel(uint8_t pin) {
+  return pin < MOCK_PINS ? pinLevels[pin] : LOW;
+}
+
+uint32_t mockPwmDuty(uint8_t pin) {
+  return pin < MOCK_PINS ? pwmDuty[pin] : 0;
+}
+
+uint32_t mockPwmWrites(uint8_t pin) {
+  return pin < MOCK_PINS ? pwmWrites[pin] : 0;
+}
+
+unsigned long mockPwmWriteMicros(uint8_t pin) {
+  return pin < MOCK_PINS ? (unsigned long)pwmWriteMicros[pin] : 0;
+}
+
+// --- Arduino API ---
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+char* ltoa(long value, char* str, int base) {
+  // Same output as avr-libc / arduino-esp32: digits in base 2-36, '-' only for base 10
+  char digits[66];
+  char* out = str;
+  unsigned long magnitude = (unsigned long)value;
+  if (value < 0 && base == 10) {
+    *out++ = '-';
+    magnitude = -(unsigned long)value;
+  }
+  int count = 0;
+  do {
+    int digit = magnitude % base;
+    digits[count++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    magnitude /= base;
+  } while (magnitude);
+  while (count) {
+    *out++ = digits[--count];
+  }
+  *out = '\0';
+  return str;
+}
+
+char* itoa(int value, char* str, int base) {
+  return ltoa(base == 10 ? value : (long)(unsigned int)value, str, base);
+}
+
+unsigned long millis() { return (unsigned long)(nowMicros / 1000); }
+unsigned long micros() { return (unsigned long)nowMicros; }
+void delay(unsigned long ms) { mockAdvanceMicros(ms * 1000); }
+void delayMicroseconds(unsigned int us) { mockAdvanceMicros(us); }
+void yield() {}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= MOCK_PINS) return;
+  bool released = pinModes[pin] == OUTPUT && mode != OUTPUT;
+  pinModes[pin] = mode;
+  if (pin == dhtPin && released && pinLevels[pin] == LOW && nowMicros - dhtLowSince >= 1000) {
+    scheduleDhtResponse(nowMicros);
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin >= MOCK_PINS) return;
+  if (pin == dhtPin && value == LOW && pinLevels[pin] != LOW) {
+    dhtLowSince = nowMicros;
+  }
+  pinLevels[pin] = value;
+}
+
+int digitalRead(uint8_t pin) { return pin < MOCK_PINS ? pinLevels[pin] : LOW; }
+int analogRead(uint8_t pin) { return pin < MOCK_PINS ? analogValues[pin] : 0; }
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+  if (pin >= MOCK_PINS) return;
+  interruptHandlers[pin] = handler;
+  interruptModes[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < MOCK_PINS) interruptHandlers[pin] = NULL;
+}
+
+bool ledcAttach(uint8_t pin, uint32_t frequency, uint8_t resolutionBits) {
+  // Same limit as the ESP32 LEDC: the 80 MHz clock must give 2^bits steps per period
+  if (pin >= MOCK_PINS || frequency == 0 || resolutionBits < 1 || resolutionBits > 20 ||
+      (80000000ULL >> resolutionBits) < frequency) {
+    return false;
+  }
+  pwmBits[pin] = resolutionBits;
+  pwmDuty[pin] = 0;
+  pwmWrites[pin] = 0;
+  return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty) {
+  if (pin >= MOCK_PINS || pwmBits[pin] == 0) return false;
+  pwmDuty[pin] = min(duty, (uint32_t)1 << pwmBits[pin]); // 2^bits = always on
+  pwmWrites[pin]++;
+  pwmWriteMicros[pin] = nowMicros;
+  return true;
+}
+
+// --- Print / Serial ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::print(unsigned long n, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char* str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 10 && n < 0) {
+    size_t t = print('-');
+    return t + print((unsigned long)(-n), 10);
+  }
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(double number, int digits) {
+  char buf[40];
+  if (isnan(number)) return print("nan");
+  if (isinf(number)) return print("inf");
+  snprintf(buf, sizeof(buf), "%.*f", digits, number);
+  return print(buf);
+}
+
+size_t HostSerial::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+size_t HostSerial::write(const uint8_t* buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+void HostSerial::flush() { fflush(stdout); }
+
+int HostSerial::available() {
+  static bool nonBlocking = false;
+  if (!nonBlocking) {
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    nonBlocking = true;
+  }
+  int c = getchar();
+  if (c == EOF) {
+    clearerr(stdin);
+    return 0;
+  }
+  ungetc(c, stdin);
+  return 1;
+}
+
+int HostSerial::read() {
+  return available() ? getchar() : -1;
+}
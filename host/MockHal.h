@@ -0,0 +1,32 @@
+// MockHal.h
+#ifndef MockHal_h // Include guard to prevent multiple inclusions
+#define MockHal_h
+
+#include <Arduino.h>
+
+// Control side of the host HAL. Simulated time only moves when the host program
+// advances it (or the code under test calls delay()), so runs are deterministic.
+
+// Advances the simulated clock, firing any pin interrupts scheduled in between.
+void mockAdvanceMicros(unsigned long us);
+
+// Sets the value analogRead(pin) returns (0-4095).
+void mockSetAnalog(uint8_t pin, int value);
+
+// Simulates a DHT22 on pin: after a start pulse (>= 1 ms low, then release) it answers
+// with the 40-bit response for the given reading, as timed falling edges.
+void mockAttachDht22(uint8_t pin, float temperature, float humidity);
+
+// Changes the reading the simulated DHT22 reports from the next request on.
+void mockSetDht22(float temperature, float humidity);
+
+// Last value written with digitalWrite(pin).
+uint8_t mockPinLevel(uint8_t pin);
+
+// PWM on pin (ledcAttach/ledcWrite): the last duty cycle written, the number of writes
+// and the micros() time of the last one. 0 if the pin has no PWM attached.
+uint32_t mockPwmDuty(uint8_t pin);
+uint32_t mockPwmWrites(uint8_t pin);
+unsigned long mockPwmWriteMicros(uint8_t pin);
+
+#endif // End of include guard
@@ -0,0 +1,3 @@
+// Print.h (host build)
+// Adafruit_GFX includes "Print.h"; the host Print class lives in Arduino.h.
+#include <Arduino.h>
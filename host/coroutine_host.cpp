@@ -0,0 +1,59 @@
+// coroutine_host.cpp
+// Runs the sketch's sensor coroutines (SensorTasks.cpp) on Linux against the mock HAL:
+// a simulated DHT22 answering with timed edges and a fixed soil ADC value. Prints the
+// shared SensorReadings once per simulated second, the first time as soon as all three
+// readings are valid (the sketch's fast start schedule).
+//
+// Usage: coroutine_host [seconds]
+
+#include <stdio.h>
+#include <math.h>
+#include "MockHal.h"
+#include "SensorTasks.h"
+
+#define DHTPIN 13
+#define SOIL_MOISTURE_PIN 27
+
+Seqlock<SensorReadings> sensorState;
+DhtCapture dhtCapture(DHTPIN);
+CoExecutor coExecutor;
+
+// Stands in for the sketch's inferenceStep(): reports what the coroutines published
+void reportStep(unsigned long currentTime) {
+  SensorReadings readings = sensorState.read();
+  printf("t=%5lums  temp=%5.1f (age %4lums)  humid=%5.1f (age %4lums)  soil=%5.1f (age %4lums)\n",
+         currentTime,
+         readings.temperature, readingAge(readings.temperatureMillis, currentTime),
+         readings.humidity, readingAge(readings.humidityMillis, currentTime),
+         readings.soilMoisture, readingAge(readings.soilMoistureMillis, currentTime));
+}
+
+// All three readings present (the early test of the first report)
+bool readingsComplete(void*) {
+  SensorReadings readings = sensorState.read();
+  return !isnan(readings.temperature) && !isnan(readings.humidity) && !isnan(readings.soilMoisture);
+}
+
+int main(int argc, char** argv) {
+  unsigned long seconds = argc > 1 ? strtoul(argv[1], NULL, 10) : 10;
+
+  mockAttachDht22(DHTPIN, 24.3, 61.5);
+  mockSetAnalog(SOIL_MOISTURE_PIN, 2600);
+
+  if (!coExecutor.spawn(dhtTask(dhtCapture, sensorState, 2000, 1000)) ||  // After the DHT22 warm-up
+      !coExecutor.spawn(soilTask(SOIL_MOISTURE_PIN, sensorState, 500, 0)) ||
+      !coExecutor.spawn(periodicTask(reportStep, 1000, readingsComplete, NULL))) {
+    fprintf(stderr, "Error: Not enough coroutine frame slots\n");
+    return 1;
+  }
+
+  unsigned long polls = 0;
+  while (millis() < seconds * 1000) {
+    coExecutor.poll();
+    polls++;
+    if (millis() == 5000) mockSetDht22(-3.7, 88.0); // Change the reading halfway through
+    mockAdvanceMicros(100); // Loop iteration time on the target is in this range
+  }
+  printf("%lu polls, %u coroutines still running\n", polls, coExecutor.activeCount());
+  return 0;
+}
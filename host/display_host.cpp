@@ -0,0 +1,250 @@
+// display_host.cpp
+// Renders FuzzyDisplay on Linux into the mock ST7735 (host/Adafruit_SPITFT.h) through a
+// fixed sequence of readings, pages and scrolling, and prints the SPI traffic every
+// updateValues() call would have caused on the panel.
+//
+// Every step has a traffic budget (commands, pixels and bytes sent, the worst call of a
+// group of updates): the run fails with exit status 1 if a step goes over it, so a change
+// that makes the display chattier is caught without any reference files. The frames at
+// the checkpoints can also be written as PPM images, or compared with images written
+// before (golden images, e.g. from the last commit, before changing the drawing code).
+//
+// Usage: display_host [--write DIR | --check DIR]
+//   --write DIR  writes DIR/<checkpoint>.ppm
+//   --check DIR  compares with DIR/<checkpoint>.ppm; exit status 1 if any frame differs
+
+#include <stdio.h>
+#include <string.h>
+#include "MockHal.h"
+#include "FuzzyDisplay.h"
+
+#define TFT_CS    5
+#define TFT_RST   4
+#define TFT_DC    22
+
+FuzzyDisplay myDisplay(TFT_CS, TFT_DC, TFT_RST);
+
+static const char* writeDir = NULL;
+static const char* checkDir = NULL;
+static bool failed = false;
+
+// Traffic totals over a group of updateValues() calls, and the worst single call
+struct TrafficTotals {
+  uint32_t calls;
+  uint64_t commands, windows, pixels, bytes;
+  uint32_t maxCommands, maxPixels, maxBytes;
+};
+
+// Most SPI traffic one step may cause. The budgets hold for the direct and the
+// framebuffer build with about 25% headroom over what they send now.
+struct TrafficBudget {
+  uint32_t commands, pixels, bytes;
+};
+
+static const TrafficBudget LAYOUT_BUDGET = {10300, 35000, 107500};
+static const TrafficBudget READINGS_BUDGET = {19, 2720, 5500};
+static const TrafficBudget BACKGROUND_BUDGET = {19, 4870, 9800};
+static const TrafficBudget HISTORY_PAGE_BUDGET = {1960, 48000, 103200};
+static const TrafficBudget CHART_BUDGET = {5, 320, 660};
+static const TrafficBudget RULES_BUDGET = {98, 6530, 13130};
+static const TrafficBudget MEMBERSHIP_PAGE_BUDGET = {5900, 41760, 105170};
+static const TrafficBudget MEMBERSHIP_BUDGET = {23, 590, 1270};
+
+// Checks the traffic of a step against its budget
+static void checkBudget(const char* name, uint32_t commands, uint32_t pixels, uint32_t bytes,
+                        const TrafficBudget& budget) {
+  bool within = commands <= budget.commands && pixels <= budget.pixels && bytes <= budget.bytes;
+  if (!within) {
+    failed = true;
+  }
+  printf("[%s] %s: %lu/%lu commands, %lu/%lu pixels, %lu/%lu bytes\n", within ? "ok" : "OVER", name,
+         (unsigned long)commands, (unsigned long)budget.commands, (unsigned long)pixels,
+         (unsigned long)budget.pixels, (unsigned long)bytes, (unsigned long)budget.bytes);
+}
+
+// Checks the worst call of a group against its budget
+static void checkBudget(const char* name, const TrafficTotals& totals, const TrafficBudget& budget) {
+  checkBudget(name, totals.maxCommands, totals.maxPixels, totals.maxBytes, budget);
+}
+
+// Checks the traffic since the last resetTraffic() against its budget
+static void checkBudget(const char* name, const TrafficBudget& budget) {
+  const PanelTraffic& t = Adafruit_SPITFT::mockInstance()->traffic();
+  checkBudget(name, t.commands, t.pixels, t.bytes, budget);
+}
+
+// Writes or checks the visible frame under name
+static void checkpoint(const char* name) {
+  Adafruit_SPITFT* panel = Adafruit_SPITFT::mockInstance();
+  char path[512];
+  if (writeDir) {
+    snprintf(path, sizeof(path), "%s/%s.ppm", writeDir, name);
+    if (!panel->writePpm(path)) {
+      fprintf(stderr, "Error: Cannot write %s\n", path);
+      failed = true;
+    }
+  }
+  if (checkDir) {
+    snprintf(path, sizeof(path), "%s/%s.ppm", checkDir, name);
+    int32_t differences = panel->comparePpm(path);
+    if (differences != 0) {
+      failed = true;
+    }
+    printf("[%s] %s: %s", differences == 0 ? "same" : "DIFF", name, path);
+    if (differences > 0) printf(" (%ld pixels)", (long)differences);
+    if (differences < 0) printf(" (missing or wrong size)");
+    printf("\n");
+  }
+}
+
+// One updateValues() call, one second of simulated time apart (or secondsLater)
+static void update(float temp, float humid, float soil, float pump, TrafficTotals& totals,
+                   bool printLine, unsigned long secondsLater = 1) {
+  mockAdvanceMicros(secondsLater * 1000000UL);
+  Adafruit_SPITFT* panel = Adafruit_SPITFT::mockInstance();
+  panel->resetTraffic();
+  myDisplay.updateValues(temp, humid, soil, pump);
+  const PanelTraffic& t = panel->traffic();
+
+  totals.calls++;
+  totals.commands += t.commands;
+  totals.windows += t.addressWindows;
+  totals.pixels += t.pixels;
+  totals.bytes += t.bytes;
+  totals.maxCommands = max(totals.maxCommands, t.commands);
+  totals.maxPixels = max(totals.maxPixels, t.pixels);
+  totals.maxBytes = max(totals.maxBytes, t.bytes);
+  if (printLine) {
+    printf("%6.1f %6.1f %6.1f %6.1f | %5lu %5lu %6lu %7lu",
+           temp, humid, soil, pump,
+           (unsigned long)t.commands, (unsigned long)t.addressWindows,
+           (unsigned long)t.pixels, (unsigned long)t.bytes);
+#if FUZZY_FRAMEBUFFER && !FUZZY_DMA_FLUSH
+    // The framebuffer's own estimate should match what the panel received
+    printf(" | flush %lu B", (unsigned long)myDisplay.lastFlushStats().bytes);
+#endif
+    printf("\n");
+  }
+}
+
+// Prints the averages of a group of calls
+static void summary(const char* label, const TrafficTotals& totals) {
+  if (totals.calls == 0) return;
+  printf("%-28s %4lu calls, per call: %7.1f commands %6.1f windows %8.1f pixels %9.1f bytes\n",
+         label, (unsigned long)totals.calls,
+         (double)totals.commands / totals.calls, (double)totals.windows / totals.calls,
+         (double)totals.pixels / totals.calls, (double)totals.bytes / totals.calls);
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--write") == 0) writeDir = argv[i + 1];
+    else if (strcmp(argv[i], "--check") == 0) checkDir = argv[i + 1];
+  }
+
+  myDisplay.begin();
+  // Input sets of FuzzyLogic.ino (temperature, humidity, soil; low to high)
+  static const float sets[MEMBERSHIP_INPUTS][RULE_GRID_LEVELS][4] = {
+    {{-5, -5, 10, 20}, {10, 20, 20, 30}, {20, 30, 45, 45}},
+    {{0, 0, 30, 50}, {30, 50, 50, 70}, {50, 70, 100, 100}},
+    {{0, 0, 20, 35}, {20, 35, 40, 55}, {40, 55, 100, 100}}
+  };
+  for (uint8_t input = 0; input < MEMBERSHIP_INPUTS; input++) {
+    for (uint8_t level = 0; level < RULE_GRID_LEVELS; level++) {
+      const float* p = sets[input][level];
+      myDisplay.setMembershipSet(input, level, p[0], p[1], p[2], p[3]);
+    }
+  }
+  Adafruit_SPITFT::mockInstance()->resetTraffic();
+  myDisplay.drawLayout();
+  const PanelTraffic& layout = Adafruit_SPITFT::mockInstance()->traffic();
+  printf("drawLayout: %lu commands, %lu windows, %lu pixels, %lu bytes\n",
+         (unsigned long)layout.commands, (unsigned long)layout.addressWindows,
+         (unsigned long)layout.pixels, (unsigned long)layout.bytes);
+  checkBudget("drawLayout", LAYOUT_BUDGET);
+  checkpoint("00-layout");
+
+  // Readings page: first values arrive, then slow drifts with a pump ramp through all bands
+  printf("  temp  humid   soil   pump |  cmds  wins pixels   bytes\n");
+  TrafficTotals readings = {0, 0, 0, 0, 0, 0, 0, 0};
+  update(NAN, NAN, 41.0, NAN, readings, true);
+  for (int i = 0; i < 30; i++) {
+    update(22.0 + 0.03 * i, 55.0 - 0.1 * i, 41.0 + 0.5 * i, i * 3.5, readings, true);
+  }
+  summary("Readings page updates:", readings);
+  checkBudget("readings update", readings, READINGS_BUDGET);
+  checkpoint("01-readings");
+
+  // More than a full chart of one-minute samples, still on the readings page
+  TrafficTotals background = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < HistoryBuffer::CAPACITY + 20; i++) {
+    float soil = 50 + 30 * sin(i * 0.07);
+    float pump = soil < 45 ? 80 - soil : 0;
+    update(23.0, 50.0, soil, pump, background, false, 60);
+  }
+  summary("Updates a minute apart:", background);
+  checkBudget("minute update", background, BACKGROUND_BUDGET);
+
+  // History page: full redraw, then one new column per minute (scrolling when it's full)
+  Adafruit_SPITFT::mockInstance()->resetTraffic();
+  myDisplay.showPage(FuzzyDisplay::PAGE_HISTORY);
+  const PanelTraffic& page = Adafruit_SPITFT::mockInstance()->traffic();
+  printf("showPage(PAGE_HISTORY): %lu commands, %lu windows, %lu pixels, %lu bytes\n",
+         (unsigned long)page.commands, (unsigned long)page.addressWindows,
+         (unsigned long)page.pixels, (unsigned long)page.bytes);
+  checkBudget("history page", HISTORY_PAGE_BUDGET);
+  checkpoint("02-history");
+
+  TrafficTotals chart = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < 10; i++) {
+    update(23.0, 50.0, 20 + 6 * i, 100 - 10 * i, chart, false, 60);
+  }
+  summary("History page, new column:", chart);
+  checkBudget("history column", chart, CHART_BUDGET);
+  checkpoint("03-history-scrolled");
+
+  myDisplay.showPage(FuzzyDisplay::PAGE_READINGS);
+  checkpoint("04-readings-again");
+
+  // Rule page: a synthetic firing pattern, then the same pattern moved by one cell
+  uint8_t firing[RULE_GRID_CELLS];
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    firing[cell] = (cell * 37) % 11 == 0 ? 255 - cell * 7 : (cell % 4) * 20;
+  }
+  myDisplay.setRuleFiring(firing);
+  myDisplay.showPage(FuzzyDisplay::PAGE_RULES);
+  checkpoint("05-rules");
+
+  TrafficTotals rules = {0, 0, 0, 0, 0, 0, 0, 0};
+  memmove(firing + 1, firing, RULE_GRID_CELLS - 1);
+  myDisplay.setRuleFiring(firing);
+  update(23.0, 50.0, 40.0, 30.0, rules, false);
+  summary("Rule page, pattern shifted:", rules);
+  checkBudget("rule update", rules, RULES_BUDGET);
+  checkpoint("06-rules-changed");
+
+  // Membership page: curves drawn once, then each update moves the markers and degrees
+  uint8_t degrees[MEMBERSHIP_CELLS] = {0, 70, 30, 50, 50, 0, 0, 33, 67};
+  myDisplay.setMemberships(degrees);
+  Adafruit_SPITFT::mockInstance()->resetTraffic();
+  myDisplay.showPage(FuzzyDisplay::PAGE_MEMBERSHIP);
+  const PanelTraffic& membershipPage = Adafruit_SPITFT::mockInstance()->traffic();
+  printf("showPage(PAGE_MEMBERSHIP): %lu commands, %lu windows, %lu pixels, %lu bytes\n",
+         (unsigned long)membershipPage.commands, (unsigned long)membershipPage.addressWindows,
+         (unsigned long)membershipPage.pixels, (unsigned long)membershipPage.bytes);
+  checkBudget("membership page", MEMBERSHIP_PAGE_BUDGET);
+  checkpoint("07-membership");
+
+  TrafficTotals membership = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = 1; i <= 10; i++) {
+    degrees[1] = 70 - 2 * i; // Temperature drifting from medium to high
+    degrees[2] = 30 + 2 * i;
+    myDisplay.setMemberships(degrees);
+    update(23.0 + 0.1 * i, 40.0, 37.0, 30.0, membership, false);
+  }
+  summary("Membership page, drift:", membership);
+  checkBudget("membership update", membership, MEMBERSHIP_BUDGET);
+  checkpoint("08-membership-moved");
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+// flashlog_tool.cpp
+// Host side of the flash data log (FuzzyLogic/FlashLog.h), on a file-backed flash image
+// (host/FileFlash.h) with the layout of the device's "datalog" partition.
+//
+// Usage:
+//   flashlog_tool extract IMAGE                  Prints every record of the log as CSV, oldest first
+//   flashlog_tool simulate IMAGE SAMPLES [BOOTS] Appends SAMPLES synthetic records over BOOTS
+//                                                boots (the RAM block of every other boot is
+//                                                lost, as on a reset) and reports the flash wear
+//                                                and the compressed size
+//
+// Read the partition from the device with (offset and size from partitions.csv):
+//   esptool.py read_flash 0x290000 0x15F000 datalog.bin
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FileFlash.h"
+#include "FlashLog.h"
+#include "FixedFormat.h"
+
+static const uint32_t PARTITION_SIZE = 0x15F000; // datalog partition in partitions.csv
+
+// Writes a tenths field, or nothing for a missing reading
+static void printTenths(int16_t tenths) {
+  char text[12];
+  if (tenths != TENTHS16_NAN) {
+    formatTenths(tenths, text);
+    fputs(text, stdout);
+  }
+}
+
+// Visitor: one CSV row per record
+static void printRecord(const FlashLogRecord& record, void*) {
+  printf("%u,%lu,", (unsigned)record.boot, (unsigned long)record.uptimeSeconds);
+  printTenths(record.temperature);
+  putchar(',');
+  printTenths(record.humidity);
+  putchar(',');
+  printTenths(record.soilMoisture);
+  putchar(',');
+  printTenths(record.pumpPower);
+  printf(",%d\n", (record.flags & FLASH_LOG_INPUTS_VALID) ? 1 : 0);
+}
+
+static int extract(const char* path) {
+  FileFlash flash(path, 0);
+  FlashLog log(flash);
+  if (!flash.isOpen() || !log.begin()) {
+    fprintf(stderr, "Error: %s is not a readable flash image of at least two sectors\n", path);
+    return 1;
+  }
+  printf("boot,uptime_s,temperature_c,humidity_pct,soil_moisture_pct,pump_power_pct,inputs_valid\n");
+  uint32_t records = log.forEach(printRecord, NULL);
+  fprintf(stderr, "%lu records in %lu pages (%.2f bytes each, the ring keeps at least %lu pages), last boot %u, highest sector erase count %lu\n",
+          (unsigned long)records, (unsigned long)log.storedPages(),
+          records ? (double)log.storedPages() * FlashLog::PAGE_BYTES / records : 0.0,
+          (unsigned long)log.capacityPages(), (unsigned)(log.bootNumber() - 1), (unsigned long)log.maxEraseCount());
+  return 0;
+}
+
+static int simulate(const char* path, uint32_t samples, uint32_t boots) {
+  FileFlash flash(path, PARTITION_SIZE);
+  if (!flash.isOpen()) {
+    fprintf(stderr, "Error: Cannot open %s\n", path);
+    return 1;
+  }
+  uint32_t lost = 0;
+  for (uint32_t b = 0; b < boots; b++) {
+    FlashLog log(flash); // A fresh mount, as after a reset
+    if (!log.begin()) {
+      fprintf(stderr, "Error: Image too small\n");
+      return 1;
+    }
+    uint32_t count = samples / boots + (b < samples % boots ? 1 : 0);
+    for (uint32_t i = 0; i < count; i++) {
+      float t = (float)i / 8640.0f; // Days at one record per 10 s
+      FlashLogRecord record;
+      record.boot = log.bootNumber();
+      record.uptimeSeconds = i * 10;
+      record.temperature = toTenths16(24.0f + 6.0f * sinf(t * 6.283f));
+      record.humidity = toTenths16(55.0f - 15.0f * sinf(t * 6.283f));
+      record.soilMoisture = toTenths16(40.0f + 20.0f * cosf(t * 31.4f));
+      record.pumpPower = toTenths16(record.soilMoisture < 350 ? 60.0f : 0.0f);
+      record.flags = FLASH_LOG_INPUTS_VALID;
+      log.append(record);
+    }
+    if (b % 2 == 0) {
+      log.flush(); // Orderly shutdown
+    } else {
+      lost += log.pendingRecords(); // Reset: the RAM block is gone
+    }
+  }
+
+  uint32_t sectors = flash.size() / flash.sectorSize();
+  uint32_t minErases = UINT32_MAX, maxErases = 0;
+  for (uint32_t s = 0; s < sectors; s++) {
+    minErases = min(minErases, flash.sectorErases(s));
+    maxErases = max(maxErases, flash.sectorErases(s));
+  }
+  FlashLog log(flash);
+  log.begin();
+  printf("%lu samples over %lu boots, %lu lost in RAM blocks at resets\n",
+         (unsigned long)samples, (unsigned long)boots, (unsigned long)lost);
+  printf("%lu records in flash, %lu pages: %.2f bytes per sample (16 uncompressed)\n",
+         (unsigned long)log.storedRecords(), (unsigned long)log.storedPages(),
+         log.storedRecords() ? (double)log.storedPages() * FlashLog::PAGE_BYTES / log.storedRecords() : 0.0);
+  printf("%lu flash writes (%.1f records each), sector erases this run: min %lu max %lu over %lu sectors\n",
+         (unsigned long)flash.writeCalls(), flash.writeCalls() ? (double)(samples - lost) / flash.writeCalls() : 0.0,
+         (unsigned long)minErases, (unsigned long)maxErases, (unsigned long)sectors);
+  if (!flash.save()) {
+    fprintf(stderr, "Error: Cannot write %s\n", path);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc >= 3 && strcmp(argv[1], "extract") == 0) {
+    return extract(argv[2]);
+  }
+  if (argc >= 4 && strcmp(argv[1], "simulate") == 0) {
+    return simulate(argv[2], strtoul(argv[3], NULL, 10), argc >= 5 ? strtoul(argv[4], NULL, 10) : 1);
+  }
+  fprintf(stderr, "Usage: %s extract IMAGE | simulate IMAGE SAMPLES [BOOTS]\n", argv[0]);
+  return 2;
+}
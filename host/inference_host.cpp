@@ -0,0 +1,81 @@
+// inference_host.cpp
+// Checks the sketch's inference (FuzzyEngine.cpp) on Linux with the crop profiles
+// (CropProfiles.cpp): readings outside a variable's range, as a DHT22 reports them up to
+// 80 degrees C, must give the same memberships and pump power as the nearest end of the
+// range, with the exact centroid and with an output table. Prints one line per case and
+// exits with 1 if any case fails.
+//
+// Usage: inference_host
+
+#include <stdio.h>
+#include "FuzzyEngine.h"
+#include "ModelBlob.h"
+#include "CropProfiles.h"
+
+static const ModelProfile PROFILES[] = {
+  {"tomato", &TOMATO_MODEL},
+  {"succulent", &SUCCULENT_MODEL},
+  {"seedling", &SEEDLING_MODEL}
+};
+
+// Inputs the out-of-range readings are combined with
+static const float BASE_INPUTS[][MODEL_INPUTS] = {
+  {25, 40, 10},  // Warm, dry soil
+  {30, 80, 50},  // Humid, moist soil
+  {10, 20, 90}   // Cool, wet soil
+};
+
+static const float OUTSIDE_MARGINS[] = {0.5, 10, 35};
+
+// Runs inputs with value at input, once outside the range and once at its end.
+// True if both give the same result.
+static bool checkCase(const char* name, const ModelBlob& blob, const float base[MODEL_INPUTS],
+                      uint8_t input, float outside, float end) {
+  float inputs[MODEL_INPUTS], clamped[MODEL_INPUTS];
+  memcpy(inputs, base, sizeof(inputs));
+  memcpy(clamped, base, sizeof(clamped));
+  inputs[input] = outside;
+  clamped[input] = end;
+
+  InferenceResult result, expected;
+  runInference(blob, inputs, result);
+  runInference(blob, clamped, expected);
+  bool same = result.pumpPower == expected.pumpPower &&
+              memcmp(result.memberships, expected.memberships, sizeof(result.memberships)) == 0;
+  printf("%-9s %s %-5s=%6.1f -> pump %5.1f%% (range end %6.1f: %5.1f%%) %s\n",
+         name, blob.flags & MODEL_BLOB_HAS_OUTPUT_TABLE ? "table" : "exact", modelVariableName(input),
+         outside, result.pumpPower, end, expected.pumpPower, same ? "ok" : "FAILED");
+  return same;
+}
+
+int main() {
+  uint32_t failures = 0;
+  for (const ModelProfile& profile : PROFILES) {
+    static ModelBlob withTable;
+    buildModelBlob(profile.blob->model, true, withTable);
+    const ModelBlob* blobs[] = {profile.blob, &withTable};
+    for (const ModelBlob* blob : blobs) {
+      for (const float* base : BASE_INPUTS) {
+        for (uint8_t input = 0; input < MODEL_INPUTS; input++) {
+          float low, high;
+          modelVariableRange(input, low, high);
+          for (float margin : OUTSIDE_MARGINS) {
+            failures += !checkCase(profile.name, *blob, base, input, low - margin, low);
+            failures += !checkCase(profile.name, *blob, base, input, high + margin, high);
+          }
+        }
+      }
+    }
+  }
+
+  // The hottest greenhouse must still be watered: 60 degrees C, dry air, dry soil
+  const float heatwave[MODEL_INPUTS] = {60, 15, 5};
+  InferenceResult result;
+  runInference(TOMATO_MODEL, heatwave, result);
+  bool watered = result.pumpPower > 50;
+  printf("tomato    heatwave 60 C, 15%% RH, 5%% soil -> pump %5.1f%% %s\n", result.pumpPower, watered ? "ok" : "FAILED");
+  failures += !watered;
+
+  printf("%u failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// pump_host.cpp
+// Runs the sketch's PumpDriver on Linux against the mock PWM (MockHal). A script of pump
+// power commands, one per simulated second as inference would send them, shows the soft
+// start, the minimum power and on-time, and the stops on stale inputs: once commands stop
+// arriving, and once the DHT22 fails while the soil sensor keeps updating (the failed
+// reads keep the previous temperature, humidity and timestamps, as in the sketch).
+// Prints the PWM duty cycle every 250 ms and the latency and oldest input age of every
+// command.
+//
+// Usage: pump_host
+
+#include <stdio.h>
+#include "MockHal.h"
+#include "PumpDriver.h"
+#include "SensorReadings.h"
+
+#define PUMP_PWM_PIN 25
+
+// Same settings and sensor intervals as the sketch
+PumpDriver pumpDriver(PUMP_PWM_PIN, 20.0, 25.0, 10000, 5000);
+const unsigned long DHT_INTERVAL_MILLIS = 2000;
+const unsigned long SOIL_INTERVAL_MILLIS = 500;
+
+// Pump power inference sends each second; a negative entry sends nothing (inputs invalid)
+const float SCRIPT[] = {0, 12, 70, 70, 70, 70, 35, 0, 0, 0, 0, 0, 0, 0, 85, 85, -1, -1, -1, -1, -1, -1,
+                        60, 60, 60, 60, 60, 60, 60, 60, 60, 60};
+const unsigned long DHT_FAILS_FROM_MILLIS = 25000; // Every DHT22 read fails from here on
+const unsigned long SAMPLE_AGE_MICROS = 5000;      // Newest sensor read to inference
+
+int main() {
+  if (!pumpDriver.begin()) {
+    fprintf(stderr, "Error: PWM attach failed\n");
+    return 1;
+  }
+
+  unsigned long dhtMillis = 0, soilMillis = 0; // Time of the last good read of each sensor
+  unsigned long maxLatency = 0;
+  for (unsigned long tick = 0; tick < sizeof(SCRIPT) / sizeof(SCRIPT[0]) * 4; tick++) {
+    if (tick % 4 == 0) {
+      float power = SCRIPT[tick / 4];
+      if (power >= 0) {
+        mockAdvanceMicros(SAMPLE_AGE_MICROS);
+        unsigned long inputAge = max(readingAge(dhtMillis, millis()), readingAge(soilMillis, millis()));
+        unsigned long latency = pumpDriver.command(power, micros() - SAMPLE_AGE_MICROS, inputAge);
+        if (latency > maxLatency) maxLatency = latency;
+        printf("t=%5lums  command %5.1f%%  latency %5luus  oldest input %4lums\n", millis(), power, latency, inputAge);
+      }
+    }
+    // The sketch calls update() every loop pass; 1 ms steps are close enough here
+    for (unsigned int ms = 0; ms < 250; ms++) {
+      mockAdvanceMicros(1000);
+      unsigned long now = millis();
+      if (now % SOIL_INTERVAL_MILLIS == 0) soilMillis = now;
+      if (now % DHT_INTERVAL_MILLIS == 0 && now < DHT_FAILS_FROM_MILLIS) dhtMillis = now;
+      pumpDriver.update(micros());
+    }
+    uint32_t duty = mockPwmDuty(PUMP_PWM_PIN);
+    printf("t=%5lums  duty %4u/%lu (%5.1f%%)\n", millis(), duty, (unsigned long)PumpDriver::PWM_MAX,
+           duty * 100.0 / PumpDriver::PWM_MAX);
+  }
+  printf("%u starts, %u stale stops, %u PWM writes, max latency %luus\n",
+         pumpDriver.starts(), pumpDriver.staleStops(), mockPwmWrites(PUMP_PWM_PIN), maxLatency);
+  return 0;
+}
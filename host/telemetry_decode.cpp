@@ -0,0 +1,95 @@
+// telemetry_decode.cpp
+// Converts the binary telemetry stream of the sketch (FUZZY_TELEMETRY, FuzzyLogic/Telemetry.h)
+// into CSV: one row per record, one column per field, readings in their units and empty
+// fields for missing values, ready for a spreadsheet, pandas or a CSV-to-Parquet converter.
+// Damaged frames and text between frames are skipped; a summary goes to stderr.
+//
+// Usage: telemetry_decode [FILE]   (reads stdin without FILE, e.g. a captured serial port)
+
+#include <stdio.h>
+#include "Telemetry.h"
+#include "FixedFormat.h"
+
+// Writes a tenths field in its unit, or nothing for TELEMETRY_NO_VALUE
+static void printTenths(FILE* out, int16_t tenths) {
+  char text[12];
+  if (tenths != TELEMETRY_NO_VALUE) {
+    formatTenths(tenths, text);
+    fputs(text, out);
+  }
+}
+
+// Writes one record as a CSV row
+static void printRecord(FILE* out, const TelemetryRecord& record) {
+  fprintf(out, "%u,%lu,", (unsigned)record.sequence, (unsigned long)record.timeMillis);
+  printTenths(out, record.temperature);
+  fputc(',', out);
+  printTenths(out, record.humidity);
+  fputc(',', out);
+  printTenths(out, record.soilMoisture);
+  fputc(',', out);
+  printTenths(out, record.pumpPower);
+  fprintf(out, ",%d,%lu", (record.flags & TELEMETRY_INPUTS_VALID) ? 1 : 0, (unsigned long)record.latencyMicros);
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    fprintf(out, ",%u", (unsigned)record.ruleFiring[cell]);
+  }
+  fputc('\n', out);
+}
+
+int main(int argc, char** argv) {
+  FILE* in = stdin;
+  if (argc > 1) {
+    in = fopen(argv[1], "rb");
+    if (!in) {
+      fprintf(stderr, "Error: Cannot open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  // Header: rule columns named by set levels, temperature/humidity/soil (0 = low .. 2 = high)
+  printf("sequence,time_ms,temperature_c,humidity_pct,soil_moisture_pct,pump_power_pct,inputs_valid,latency_us");
+  for (uint8_t cell = 0; cell < RULE_GRID_CELLS; cell++) {
+    printf(",rule_t%uh%us%u", cell / 9, cell / 3 % 3, cell % 3);
+  }
+  printf("\n");
+
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  size_t length = 0;
+  bool overflow = false;
+  unsigned long bytes = 0, records = 0, damaged = 0, missing = 0, restarts = 0;
+  bool first = true;
+  uint16_t expected = 0;
+  int c;
+  while ((c = fgetc(in)) != EOF) {
+    bytes++;
+    if (c != 0) {
+      if (length < sizeof(frame)) frame[length++] = (uint8_t)c;
+      else overflow = true; // Not a record (e.g. a long text line): dropped at the delimiter
+      continue;
+    }
+    // Delimiter: whatever was collected since the last one is a frame candidate
+    if (length > 0) {
+      TelemetryRecord record;
+      if (!overflow && decodeTelemetry(frame, length, record)) {
+        uint16_t gap = record.sequence - expected;
+        if (!first && gap != 0) {
+          if (gap < 0x8000) missing += gap; // Records lost in between
+          else restarts++;                  // Counter went back: the sketch restarted
+        }
+        expected = record.sequence + 1;
+        first = false;
+        records++;
+        printRecord(stdout, record);
+      } else {
+        damaged++;
+      }
+    }
+    length = 0;
+    overflow = false;
+  }
+  if (in != stdin) fclose(in);
+
+  fprintf(stderr, "%lu records, %lu damaged or non-record frames, %lu records missing, %lu restarts, "
+          "%.1f bytes per record\n", records, damaged, missing, restarts, records ? (double)bytes / records : 0.0);
+  return 0;
+}